@@ -0,0 +1,65 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_BASIC_PEOPLE_TRACKER_H
+#define PEOPLE_DETECTION_BASIC_PEOPLE_TRACKER_H
+
+#include <vector>
+#include <Eigen/Dense>
+#include <TrackerContext.h>
+#include <TrackerPolicies.h>
+
+
+//One frame of tracking: association reports lost tracks straight to the lifecycle, no runtime switch on the way
+template<class Association, class Lifecycle, class Metric>
+inline void trackFrame(TrackerContext &context, Association &association, Lifecycle &lifecycle,
+                       std::vector<person> &world, const std::vector<Eigen::Vector3f> &new_center_list)
+{
+    context.beginFrame(new_center_list);
+    lifecycle.beginFrame();
+    association.template associate<Metric>(context, lifecycle, world, new_center_list);
+    lifecycle.endFrame(context, world);
+    context.endFrame(world);
+}
+
+//Tracker specialized at compile time, e.g. BasicPeopleTracker<MultiNNAssociation, FrameCountLifecycle>
+//for what PeopleTracker does with MULTI_NEAREST_NEIGHBOR_TRACKER and UPDATE_WITH_FRAME_COUNT.
+template<class Association, class Lifecycle, class Metric = EuclideanDistance>
+class BasicPeopleTracker : public TrackerContext
+{
+    public:
+        void trackPeople(std::vector<person> &global_track_list, const std::vector<Eigen::Vector3f> &new_center_list)
+        {
+            trackFrame<Association, Lifecycle, Metric>(*this, this->association, this->lifecycle, global_track_list, new_center_list);
+        }
+
+    private:
+        Association association;
+        Lifecycle lifecycle;
+};
+
+//Type erased specialization for the runtime front-end: one virtual call per frame
+class TrackerCore
+{
+    public:
+        virtual ~TrackerCore() {}
+        virtual void trackPeople(TrackerContext &context, std::vector<person> &world, const std::vector<Eigen::Vector3f> &new_center_list) = 0;
+};
+
+template<class Association, class Lifecycle, class Metric>
+class TrackerCoreImpl : public TrackerCore
+{
+    public:
+        virtual void trackPeople(TrackerContext &context, std::vector<person> &world, const std::vector<Eigen::Vector3f> &new_center_list)
+        {
+            trackFrame<Association, Lifecycle, Metric>(context, this->association, this->lifecycle, world, new_center_list);
+        }
+
+    private:
+        Association association;
+        Lifecycle lifecycle;
+};
+
+
+#endif //PEOPLE_DETECTION_BASIC_PEOPLE_TRACKER_H
@@ -0,0 +1,103 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_COMPACT_CLOUD_H
+#define PEOPLE_DETECTION_COMPACT_CLOUD_H
+
+#include <stdint.h>
+#include <vector>
+#include <cmath>
+#include <Eigen/Dense>
+#include <sensor_msgs/PointCloud2.h>
+#include <pcl/point_types.h>
+#include <pcl/point_cloud.h>
+
+
+#define COMPACT_MAX_RANGE 32.0 //m, int16 millimeters
+
+//Detection pipeline point: 10 bytes instead of 32 for PointXYZRGBA
+typedef struct{
+    int16_t x; //mm, camera frame
+    int16_t y;
+    int16_t z;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t reserved; //keeps x,y,z 2 byte aligned in arrays
+}compact_point;
+
+//Cropped cloud of one frame in compact points, plus the RGB image of the whole frame for the classifier
+class CompactCloud
+{
+    public:
+        CompactCloud();
+        void reserve(int width, int height);
+        //Conversion fused with the crop: only finite points with 0 < z <= max_range are kept (m, at most COMPACT_MAX_RANGE).
+        //False if the cloud has no FLOAT32 x,y,z fields, is big endian or its fields/points do not fit in point_step/row_step/data
+        bool fromROSMsg(const sensor_msgs::PointCloud2 &msg, float max_range);
+        void fromPCL(const pcl::PointCloud<pcl::PointXYZRGBA> &cloud, float max_range);
+        static void toPCL(const std::vector<compact_point> &points, pcl::PointCloud<pcl::PointXYZRGBA> &cloud);
+
+        static inline int16_t toMillimeter(float m)
+        {
+            return (int16_t)lrintf(m*1000.0f);
+        }
+        static inline float toMeter(int16_t mm)
+        {
+            return mm*0.001f;
+        }
+
+        std::vector<compact_point> points;
+        pcl::PointCloud<pcl::RGB>::Ptr image; //width x height of the input, RGB of every pixel
+        uint64_t stamp; //usec, as the pcl header
+
+    private:
+        bool cropPoint(float x, float y, float z, float max_range, compact_point &p);
+};
+
+//Stages of GroundBasedPeopleDetectionApp::compute on compact points. Buffers are kept between frames
+class CompactCloudFilter
+{
+    public:
+        //Centroid (rounded to mm) and mean color (truncated, as pcl::VoxelGrid) of the points in each leaf_size voxel.
+        //Voxels are ordered by z, y, x index like pcl::VoxelGrid. Serial reference of VoxelDownsampler
+        void voxelDownsample(const std::vector<compact_point> &in, float leaf_size, std::vector<compact_point> &out);
+        //Points not closer than distance (m) to the plane (unit normal) go to out. With at least min_refit inliers the plane
+        //is refit to them (least squares, normal kept on the side of the given one). Return the inlier count
+        int removePlane(const std::vector<compact_point> &in, Eigen::Vector4f &plane, float distance, int min_refit,
+                        std::vector<compact_point> &out);
+        //Connected components of points within tolerance (m) of each other, as pcl::EuclideanClusterExtraction: clusters of
+        //min_size to max_size points, largest first, indices ascending
+        void euclideanClusters(const std::vector<compact_point> &points, float tolerance, int min_size, int max_size,
+                               std::vector<std::vector<int> > &clusters);
+
+    private:
+        typedef struct{
+            int64_t key;
+            int index;
+        }keyed_index;
+
+        static bool keyLess(const keyed_index &a, const keyed_index &b)
+        {
+            if(a.key != b.key)
+                return a.key < b.key;
+            return a.index < b.index;
+        }
+        static bool clusterLarger(const std::vector<int> &a, const std::vector<int> &b)
+        {
+            return a.size() > b.size();
+        }
+        static int floorDiv(int a, int b);
+        static int64_t cellKey(int cx, int cy, int cz);
+        int findCell(int64_t key);
+
+        std::vector<keyed_index> keyed;
+        std::vector<int64_t> cell_keys;
+        std::vector<int> cell_start; //first entry of each cell in keyed, one past the end last
+        std::vector<char> visited;
+        std::vector<int> queue;
+};
+
+
+#endif //PEOPLE_DETECTION_COMPACT_CLOUD_H
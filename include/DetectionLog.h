@@ -0,0 +1,83 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_DETECTION_LOG_H
+#define PEOPLE_DETECTION_DETECTION_LOG_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <sys/types.h>
+#include <Eigen/Dense>
+
+
+#define DETECTION_LOG_MAGIC 0x4c444450 //"PDDL"
+#define DETECTION_LOG_VERSION 1
+
+//Append-only log of getPeopleCenter output, native byte order:
+//detection_log_header, then per frame a detection_log_frame followed by count detection_log_entry
+typedef struct{
+    uint32_t magic;
+    uint32_t version;
+}detection_log_header;
+
+typedef struct{
+    double stamp;
+    uint32_t count;
+    uint32_t reserved;
+}detection_log_frame;
+
+typedef struct{
+    float x;
+    float y;
+    float z;
+    float confidence;
+}detection_log_entry;
+
+class DetectionLogWriter
+{
+    public:
+        DetectionLogWriter();
+        ~DetectionLogWriter();
+        //Append to filename, the header is written if the file is new. False if the file is not a log of this version.
+        //A frame cut by a crash at the end of the file is truncated first (getDroppedBytes)
+        bool open(std::string filename);
+        void close(void);
+        bool isOpen(void);
+        bool write(double stamp, const std::vector<Eigen::Vector3f> &centers, const std::vector<float> &confidences);
+        //Bytes of an incomplete last frame removed by the last open
+        size_t getDroppedBytes(void);
+
+    private:
+        bool validate(off_t file_size);
+
+        FILE *file;
+        size_t dropped_bytes;
+        std::vector<detection_log_entry> entry_buffer;
+};
+
+//Memory mapped reader, frames are indexed once at open. A frame cut by a crash at the end of the file is ignored
+class DetectionLogReader
+{
+    public:
+        DetectionLogReader();
+        ~DetectionLogReader();
+        bool open(std::string filename);
+        void close(void);
+        int size(void) const;
+        double getStamp(int frame) const;
+        void getFrame(int frame, std::vector<Eigen::Vector3f> &centers, std::vector<float> &confidences) const;
+
+    private:
+        DetectionLogReader(const DetectionLogReader&);
+        DetectionLogReader& operator=(const DetectionLogReader&);
+
+        const char *data;
+        size_t data_size;
+        std::vector<size_t> frame_offset;
+};
+
+
+#endif //PEOPLE_DETECTION_DETECTION_LOG_H
@@ -0,0 +1,456 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_FIXED_PEOPLE_TRACKER_H
+#define PEOPLE_DETECTION_FIXED_PEOPLE_TRACKER_H
+
+#include <stdlib.h>
+#include <array>
+#include <algorithm>
+#include <Eigen/Dense>
+#include <PersonTrack.h>
+#include <TrackerMetrics.h>
+
+
+//trackPeople status bits
+#define FIXED_TRACKER_OK 0
+#define FIXED_TRACKER_DETECTIONS_DROPPED 1 //more than MaxDetections centers: the ones past MaxDetections are ignored
+#define FIXED_TRACKER_TRACKS_DROPPED 2 //list full: new persons not created
+
+//Tracker for embedded builds: header only, storage fixed at compile time (std::array, nothing allocated after
+//construction), no exceptions, iostream, ros or boost. No history and no sharing of ids between trackers.
+//Every step is bounded by MaxTracks*MaxDetections. For inputs within capacity the track list is bit identical to
+//PeopleTracker with the same algorithm, list update method, metric and parameters.
+template<int MaxTracks, int MaxDetections, int Algorithm = MULTI_NEAREST_NEIGHBOR_TRACKER,
+         int ListUpdateMethod = UPDATE_WITH_FRAME_COUNT, class Metric = EuclideanDistance>
+class FixedPeopleTracker
+{
+    //Kalman is not implemented here: unsupported combinations do not compile instead of running Multi NN
+    static_assert((Algorithm == SINGLE_NEAREST_NEIGHBOR_TRACKER) || (Algorithm == MULTI_NEAREST_NEIGHBOR_TRACKER),
+                  "FixedPeopleTracker: Algorithm must be SINGLE_NEAREST_NEIGHBOR_TRACKER or MULTI_NEAREST_NEIGHBOR_TRACKER");
+    static_assert((ListUpdateMethod == UPDATE_NORMAL) || (ListUpdateMethod == UPDATE_WITH_FRAME_COUNT),
+                  "FixedPeopleTracker: ListUpdateMethod must be UPDATE_NORMAL or UPDATE_WITH_FRAME_COUNT");
+    static_assert((MaxTracks > 0) && (MaxDetections > 0), "FixedPeopleTracker: capacities must be positive");
+
+    public:
+        static const int max_tracks = MaxTracks;
+        static const int max_detections = MaxDetections;
+
+        FixedPeopleTracker()
+        {
+            this->next_id = 1;
+            this->track_count = 0;
+            this->track_distance_threshold = 0.3;
+            this->single_track_reset_distance = 1.0;
+            this->person_get_in_track_condition = DEFAULT_GET_IN_TRACK_CONDITION;
+            this->get_in_track_check_frame = DEFAULT_GET_IN_TRACK_CHECK_FRAME;
+            this->person_out_of_track_condition = DEFAULT_OUT_OF_TRACK_CONDITION;
+            this->velocity_smoothing = DEFAULT_VELOCITY_SMOOTHING;
+            this->frame_stamp = 0.0;
+            this->color_seed = 1;
+            this->frame_count = 0;
+        }
+
+        void setListUpdateConstraints(int getin, int getincheck, int getout)
+        {
+            this->person_get_in_track_condition = getin;
+            this->get_in_track_check_frame = getincheck;
+            this->person_out_of_track_condition = getout;
+        }
+
+        void setTrackThreshold(float distTH)
+        {
+            this->track_distance_threshold = distTH;
+        }
+
+        void setSingleTrackResetDistance(float distTH)
+        {
+            this->single_track_reset_distance = distTH;
+        }
+
+        //Sensor time (sec) of the frame given to the next trackPeople call
+        void setFrameStamp(double stamp)
+        {
+            this->frame_stamp = stamp;
+        }
+
+        //Return false (and keep the current value) if alpha is not in (0,1]
+        bool setVelocitySmoothing(float alpha)
+        {
+            if(alpha <= 0.0f || alpha > 1.0f)
+                return false;
+            this->velocity_smoothing = alpha;
+            return true;
+        }
+
+        void resetTrackID(void)
+        {
+            this->next_id = 1;
+        }
+
+        void clear(void)
+        {
+            this->track_count = 0;
+        }
+
+        int size(void) const
+        {
+            return this->track_count;
+        }
+
+        const person& operator[](int i) const
+        {
+            return this->tracks[i];
+        }
+
+        const person* data(void) const
+        {
+            return this->tracks.data();
+        }
+
+        static Eigen::Vector3f extrapolatePosition(const person &p, double stamp, double max_horizon)
+        {
+            double dt = stamp - p.stamp;
+            if(dt <= 0.0)
+                return p.points;
+            if(dt > max_horizon)
+                dt = max_horizon;
+            return p.points + p.velocity*(float)dt;
+        }
+
+        //confidences may be NULL (all 0). Return FIXED_TRACKER_OK or a combination of the *_DROPPED bits
+        int trackPeople(const Eigen::Vector3f *centers, const float *confidences, int n)
+        {
+            int status = FIXED_TRACKER_OK;
+            if(n > MaxDetections)
+            {
+                n = MaxDetections;
+                status |= FIXED_TRACKER_DETECTIONS_DROPPED;
+            }
+            if(n < 0)
+                n = 0;
+            this->frame_count = n;
+            for(int i=0; i < n; i++)
+            {
+                this->frame_centers[i] = centers[i];
+                this->frame_confidences[i] = (confidences != 0) ? confidences[i] : 0.0f;
+            }
+            this->lost_count = 0;
+            this->tracks_dropped = false;
+
+            if(Algorithm == SINGLE_NEAREST_NEIGHBOR_TRACKER)
+                this->associateSingleNN();
+            else
+                this->associateMultiNN();
+
+            if(ListUpdateMethod == UPDATE_WITH_FRAME_COUNT)
+                this->checkTrackList();
+            else
+                this->updateNormal();
+
+            if(this->tracks_dropped)
+                status |= FIXED_TRACKER_TRACKS_DROPPED;
+            return status;
+        }
+
+    private:
+        typedef struct{
+            float distance;
+            int row; //track
+            int col; //center
+        }nn_pair;
+
+        static bool pairLess(const nn_pair &a, const nn_pair &b)
+        {
+            if(a.distance != b.distance)
+                return a.distance < b.distance;
+            if(a.row != b.row)
+                return a.row < b.row;
+            return a.col < b.col;
+        }
+
+        void lostTrack(int index)
+        {
+            if(ListUpdateMethod == UPDATE_WITH_FRAME_COUNT)
+            {
+                person &p = this->tracks[index];
+                if(p.istrack)
+                    --p.outcount;
+                else
+                    --p.incount;
+            }
+            else
+            {
+                this->lost[this->lost_count++] = index;
+            }
+        }
+
+        void associateSingleNN(void)
+        {
+            if(this->track_count > 0)
+            {
+                int index = -1;
+                float min = 9999.0f;
+                for(int i = 0 ; i < this->frame_count; i++)
+                {
+                    float tmp = Metric::distance(this->tracks[0].points, this->frame_centers[i]);
+                    if((tmp < min) && (tmp < this->track_distance_threshold))
+                    {
+                        min = tmp;
+                        index = i;
+                    }
+                }
+                if(index >= 0)
+                    this->updatePersonMeasurement(this->tracks[0], this->frame_centers[index]);
+                else
+                    this->lostTrack(0);
+            }
+            else
+            {
+                Eigen::Vector3f origin;
+                origin << 1.0, 0.0, 1.0;
+                int index = -1;
+                float min = 9999.0f;
+                for(int i = 0 ; i < this->frame_count; i++)
+                {
+                    float tmp = Metric::distance(origin, this->frame_centers[i]);
+                    if((tmp < min) && (tmp <= this->single_track_reset_distance))
+                    {
+                        min = tmp;
+                        index = i;
+                    }
+                }
+                if(index >= 0)
+                    this->addNewPerson(this->frame_centers[index], false);
+            }
+        }
+
+        void associateMultiNN(void)
+        {
+            int rows = this->track_count;
+            int cols = this->frame_count;
+            if(rows == 0)
+            {
+                for(int i=0; i < cols; i++)
+                    this->addNewPerson(this->frame_centers[i], true);
+                return;
+            }
+
+            for(int r=0; r < rows; r++)
+                this->row_used[r] = 0;
+            for(int c=0; c < cols; c++)
+                this->col_used[c] = 0;
+            int pair_count = 0;
+            for(int r=0; r < rows; r++)
+            {
+                for(int c=0; c < cols; c++)
+                {
+                    nn_pair pair;
+                    pair.distance = Metric::distance(this->tracks[r].points, this->frame_centers[c]);
+                    if(pair.distance < this->track_distance_threshold)
+                    {
+                        pair.row = r;
+                        pair.col = c;
+                        this->pairs[pair_count++] = pair;
+                    }
+                }
+            }
+            std::sort(this->pairs.begin(), this->pairs.begin() + pair_count, pairLess);
+
+            int matched = 0;
+            for(int k=0; k < pair_count; k++)
+            {
+                const nn_pair &pair = this->pairs[k];
+                if(this->row_used[pair.row] || this->col_used[pair.col])
+                    continue;
+                this->row_used[pair.row] = 1;
+                this->col_used[pair.col] = 1;
+                this->updatePersonMeasurement(this->tracks[pair.row], this->frame_centers[pair.col]);
+                this->tracks[pair.row].outcount = this->person_out_of_track_condition;
+                matched++;
+            }
+
+            if(matched < rows)
+            {
+                int new_count = 0;
+                for(int c=0; c < cols; c++)
+                {
+                    if(this->col_used[c])
+                        continue;
+                    nn_pair best;
+                    best.col = c;
+                    best.row = -1;
+                    for(int r=0; r < rows; r++)
+                    {
+                        if(this->row_used[r])
+                            continue;
+                        float distance = Metric::distance(this->tracks[r].points, this->frame_centers[c]);
+                        if((best.row < 0) || (distance < best.distance))
+                        {
+                            best.distance = distance;
+                            best.row = r;
+                        }
+                    }
+                    this->pairs[new_count++] = best;
+                }
+                std::sort(this->pairs.begin(), this->pairs.begin() + new_count, pairLess);
+                for(int k=0; k < new_count; k++)
+                    this->addNewPerson(this->frame_centers[this->pairs[k].col], true);
+            }
+            else
+            {
+                for(int c=0; c < cols; c++)
+                    if(!this->col_used[c])
+                        this->addNewPerson(this->frame_centers[c], true);
+            }
+
+            for(int r=0; r < rows; r++)
+                if(!this->row_used[r])
+                    this->lostTrack(r);
+        }
+
+        void updateNormal(void)
+        {
+            for(int i=0; i < this->track_count; i++)
+                this->tracks[i].istrack = true;
+            if(this->lost_count == 0)
+                return;
+            int kept = 0;
+            int next_lost = 0;
+            for(int i=0; i < this->track_count; i++)
+            {
+                if((next_lost < this->lost_count) && (this->lost[next_lost] == i))
+                {
+                    next_lost++;
+                    continue;
+                }
+                if(kept != i)
+                    this->tracks[kept] = this->tracks[i];
+                kept++;
+            }
+            this->track_count = kept;
+        }
+
+        void checkTrackList(void)
+        {
+            int kept = 0;
+            for(int i=0; i < this->track_count; i++)
+            {
+                person &p = this->tracks[i];
+                if(p.outcount <= 0)
+                    continue;
+                if(p.istrack == false)
+                {
+                    if(p.framesage >= this->get_in_track_check_frame)
+                    {
+                        if(p.incount <= 0)
+                            continue;
+                        p.istrack = true;
+                        p.outcount = this->person_out_of_track_condition;
+                    }
+                    else
+                    {
+                        p.framesage++;
+                    }
+                }
+                else
+                {
+                    p.framesage++;
+                }
+                if(kept != i)
+                    this->tracks[kept] = p;
+                kept++;
+            }
+            this->track_count = kept;
+        }
+
+        void addNewPerson(const Eigen::Vector3f &center_points, bool id_increment)
+        {
+            if(this->track_count >= MaxTracks)
+            {
+                this->tracks_dropped = true;
+                return;
+            }
+            person &temp = this->tracks[this->track_count++];
+            temp.points = center_points;
+            temp.velocity = Eigen::Vector3f::Zero();
+            temp.stamp = this->frame_stamp;
+            float init_var = DEFAULT_INITIAL_POSITION_STDDEV*DEFAULT_INITIAL_POSITION_STDDEV;
+            temp.variance << init_var, init_var, init_var;
+            temp.confidence = this->getFrameConfidence(center_points);
+            temp.id = id_increment ? this->next_id++ : this->next_id;
+            temp.framesage = 0;
+            temp.outcount = this->person_out_of_track_condition;
+            temp.incount = this->person_get_in_track_condition;
+            temp.istrack = false;
+            temp.color = this->generateTrackerColor();
+        }
+
+        void updatePersonMeasurement(person &p, const Eigen::Vector3f &center_points)
+        {
+            double dt = this->frame_stamp - p.stamp;
+            if((dt > 0.0) && (dt <= DEFAULT_MAX_VELOCITY_GAP))
+            {
+                Eigen::Vector3f residual = center_points - extrapolatePosition(p, this->frame_stamp, DEFAULT_MAX_VELOCITY_GAP);
+                p.variance = DEFAULT_VARIANCE_SMOOTHING*residual.cwiseProduct(residual) + (1.0f - DEFAULT_VARIANCE_SMOOTHING)*p.variance;
+
+                Eigen::Vector3f raw_velocity = (center_points - p.points)/(float)dt;
+                p.velocity = this->velocity_smoothing*raw_velocity + (1.0f - this->velocity_smoothing)*p.velocity;
+            }
+            else if(dt > DEFAULT_MAX_VELOCITY_GAP)
+            {
+                p.velocity = Eigen::Vector3f::Zero();
+            }
+            p.points = center_points;
+            p.stamp = this->frame_stamp;
+            p.confidence = this->getFrameConfidence(center_points);
+        }
+
+        float getFrameConfidence(const Eigen::Vector3f &center_points)
+        {
+            for(int i=0; i < this->frame_count; i++)
+            {
+                if(this->frame_centers[i] == center_points)
+                    return this->frame_confidences[i];
+            }
+            return 0.0f;
+        }
+
+        Eigen::Vector3f generateTrackerColor()
+        {
+            Eigen::Vector3f color;
+            float r = ((double) rand_r(&this->color_seed) / (RAND_MAX));
+            float g = ((double) rand_r(&this->color_seed) / (RAND_MAX));
+            float b = ((double) rand_r(&this->color_seed) / (RAND_MAX));
+            color(0) = r;
+            color(1) = g;
+            color(2) = b;
+            return color;
+        }
+
+        std::array<person, MaxTracks> tracks;
+        int track_count;
+        std::array<Eigen::Vector3f, MaxDetections> frame_centers;
+        std::array<float, MaxDetections> frame_confidences;
+        int frame_count;
+        std::array<nn_pair, MaxTracks*MaxDetections> pairs;
+        std::array<char, MaxTracks> row_used;
+        std::array<char, MaxDetections> col_used;
+        std::array<int, MaxTracks> lost;
+        int lost_count;
+        bool tracks_dropped;
+
+        int next_id;
+        int person_out_of_track_condition;
+        int person_get_in_track_condition;
+        int get_in_track_check_frame;
+        float track_distance_threshold;
+        float single_track_reset_distance;
+        float velocity_smoothing;
+        unsigned int color_seed;
+        double frame_stamp;
+};
+
+
+#endif //PEOPLE_DETECTION_FIXED_PEOPLE_TRACKER_H
@@ -0,0 +1,85 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_HEIGHT_MAP_DETECTOR_H
+#define PEOPLE_DETECTION_HEIGHT_MAP_DETECTOR_H
+
+#include <vector>
+#include <Eigen/Dense>
+#include <CompactCloud.h>
+
+
+#define DEFAULT_HEIGHT_MAP_CELL_SIZE 0.1 //m
+#define DEFAULT_HEIGHT_MAP_MIN_DENSITY 3 //points in the 3x3 cells around a head
+#define DEFAULT_HEIGHT_MAP_PERSON_RADIUS 0.4 //m from the head, cells farther away are not part of the person
+#define HEIGHT_MAP_MAX_CELLS 1048576
+
+typedef struct{
+    int cell;
+    float height;
+    Eigen::Vector2f position; //ground plane coordinates of the cell center
+    int component;
+}height_map_head;
+
+//Candidate generation from a top-down height map, alternative to Euclidean clustering + head based subclustering.
+//Above ground points are projected on the ground plane into cells with a max height and a density (point count) channel.
+//Heads are the local maxima of the max height within the person height limits, at least head_min_distance apart.
+//Occupied cells are grouped in 8-connected components, each cell of a component goes to its nearest head within the
+//person radius: people merged in one blob are split, clutter without a head is dropped. O(points + cells)
+class HeightMapDetector
+{
+    public:
+        HeightMapDetector();
+        void setCellSize(float size);
+        void setMinDensity(int points);
+        void setPersonRadius(float radius);
+        //points above the ground plane (camera frame, unit normal towards up as getGroundCoeffs). Candidates are indices
+        //into points, ascending, one per head (highest first) with at least min_points points
+        void detect(const std::vector<compact_point> &points, const Eigen::Vector4f &ground, float min_height, float max_height,
+                    float head_min_distance, int min_points, std::vector<std::vector<int> > &candidates);
+
+        //Channels of the last detect, row major: cell = row*width + col. Heads before the min_points check
+        int getWidth(void);
+        int getHeight(void);
+        const std::vector<float>& getMaxHeightChannel(void);
+        const std::vector<int>& getDensityChannel(void);
+        const std::vector<height_map_head>& getHeads(void);
+
+    private:
+        static bool headHigher(const height_map_head &a, const height_map_head &b)
+        {
+            if(a.height != b.height)
+                return a.height > b.height;
+            return a.cell < b.cell;
+        }
+        void findHeads(float min_height, float head_min_distance);
+        void labelComponents(void);
+        void assignCells(void);
+
+        float cell_size;
+        int min_density;
+        float person_radius;
+        int width;
+        int height;
+        Eigen::Vector2f origin; //ground plane coordinates of cell (0, 0) corner
+
+        std::vector<int> point_cell; //per input point, -1 if not projected
+        std::vector<Eigen::Vector2f> point_position;
+        std::vector<float> point_height;
+        std::vector<float> max_height;
+        std::vector<int> density;
+        std::vector<float> row_buffer; //separable 3x3 passes
+        std::vector<float> dilated;
+        std::vector<int> row_sum;
+        std::vector<int> box_density;
+        std::vector<height_map_head> maxima;
+        std::vector<height_map_head> heads;
+        std::vector<int> component; //per cell, -1 empty
+        std::vector<int> queue;
+        std::vector<int> cell_head; //per cell, index in heads or -1
+        std::vector<float> cell_distance; //squared, to cell_head
+};
+
+
+#endif //PEOPLE_DETECTION_HEIGHT_MAP_DETECTOR_H
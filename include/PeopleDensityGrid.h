@@ -0,0 +1,76 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_PEOPLE_DENSITY_GRID_H
+#define PEOPLE_DETECTION_PEOPLE_DENSITY_GRID_H
+
+#include <vector>
+#include <map>
+#include <Eigen/Dense>
+#include <boost/thread/mutex.hpp>
+
+
+#define DEFAULT_DENSITY_GRID_RESOLUTION 0.25 //m
+#define DEFAULT_DENSITY_GRID_WIDTH 80 //cells
+#define DEFAULT_DENSITY_GRID_HEIGHT 80
+#define DEFAULT_DENSITY_GRID_DECAY_TIME 60.0 //s
+#define DENSITY_GRID_MIN_DENSITY 1e-3 //person seconds, decayed below: the cell is empty again
+
+typedef struct{
+    float density; //dwell time at stamp (person seconds)
+    double stamp; //last occupancy change
+    int occupancy; //tracks in the cell since stamp
+}density_cell;
+
+//Occupancy and dwell time of tracks on a fixed grid (x-y plane of the grid frame).
+//Dwell time accumulates one per second per track in the cell and decays exponentially with decay_time:
+//between two occupancy changes it has a closed form, so a cell is only written when a track enters or leaves it
+//and decayed lazily when read. Cells with dwell time left are kept in an active list for publishing.
+//All stamps are on one clock and update/removeAllTracks stamps must not go back in time: a cell never moves its
+//stamp backwards, the time between would be lost.
+class PeopleDensityGrid
+{
+    public:
+        PeopleDensityGrid();
+        //Both drop the grid contents. origin: corner of cell 0 (smallest x, y). decay_time <= 0: no decay
+        void setGeometry(float resolution, int width, int height, const Eigen::Vector2f &origin);
+        void setDecayTime(float decay_time);
+        //Tracks of one frame (grid frame positions): created, moved and removed ones touch their cells, others nothing
+        void update(const std::vector<int> &ids, const std::vector<Eigen::Vector2f> &positions, double stamp);
+        //Every track leaves the grid at stamp, dwell time is kept
+        void removeAllTracks(double stamp);
+        void clear(void);
+
+        //Dwell time decayed to stamp and track count of the cell containing center (radius <= 0) or of every cell with its
+        //center within radius. Return false if center is outside the grid
+        bool getDensity(const Eigen::Vector2f &center, float radius, double stamp, float &density, int &occupancy);
+        //Active cells (row major index, col along x) decayed to stamp. Cells decayed below DENSITY_GRID_MIN_DENSITY are dropped
+        void getActiveCells(double stamp, std::vector<int> &cells, std::vector<float> &density, std::vector<int> &occupancy);
+
+        float getResolution(void);
+        int getWidth(void);
+        int getHeight(void);
+        Eigen::Vector2f getOrigin(void);
+        float getDecayTime(void);
+
+    private:
+        int cellAt(const Eigen::Vector2f &position);
+        float decayedDensity(const density_cell &cell, double stamp);
+        void addOccupancy(int cell, int delta, double stamp);
+
+        boost::mutex grid_mutex;
+        float resolution;
+        int width;
+        int height;
+        Eigen::Vector2f origin;
+        float decay_time;
+        std::vector<density_cell> cells;
+        std::vector<int> active; //cells with occupancy or dwell time left
+        std::vector<char> is_active;
+        std::map<int, int> track_cell; //cell of every track in the last update, -1 outside the grid
+        std::map<int, int> current_cell; //update buffer
+};
+
+
+#endif //PEOPLE_DETECTION_PEOPLE_DENSITY_GRID_H
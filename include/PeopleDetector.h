@@ -21,6 +21,11 @@
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/people/person_cluster.h>
 #include <pcl/people/person_classifier.h>
+#include <pcl/people/head_based_subcluster.h>
+#include <SVMModelCache.h>
+#include <CompactCloud.h>
+#include <VoxelDownsampler.h>
+#include <HeightMapDetector.h>
 
 #include <sstream>
 #include <stdlib.h>
@@ -38,6 +43,12 @@
 
 #define DEFAULT_HEAD_MINIMUM_DISTANCE 0.2
 
+#define DEFAULT_VOXEL_SIZE 0.06
+
+#define DEFAULT_CROP_MARGIN 0.5 //m behind detect_range kept for the body of a person centered at the range
+#define DEFAULT_MIN_PERSON_WIDTH 0.1 //cluster size limits, as GroundBasedPeopleDetectionApp
+#define DEFAULT_MAX_PERSON_WIDTH 8.0
+
 
 #define COLOR_VISUALIZE //Comment this and Remake to turn-off visualizer
 
@@ -59,11 +70,31 @@ public:
     //Public Functions
     PeopleDetector();
     void initPeopleDetector(std::string svm_filename,Eigen::Matrix3f rgb_intrinsics_matrix, double minheight, double maxheight,
-                             double min_condf, double headmindist, double detect_range);
-    void getPeopleCenter(PointCloudT::Ptr cloud, std::vector<Eigen::Vector3f>& center_list );
+                             double min_condf, double headmindist, double detect_range, double voxel_size = DEFAULT_VOXEL_SIZE,
+                             std::string svm_cache_filename = "");
+    //Change detection limits without reloading the SVM: call between frames
+    void setDetectorParameters(double minheight, double maxheight, double min_condf, double headmindist,
+                               double detect_range, double voxel_size);
+    //Ground plane from tf (robot frame): false if the frame is skipped (frames not set, no ground plane from tf yet)
+    bool getPeopleCenter(PointCloudT::Ptr cloud, std::vector<Eigen::Vector3f>& center_list );
+    bool getPeopleCenter(PointCloudT::Ptr cloud, std::vector<Eigen::Vector3f>& center_list, std::vector<float>& confidence_list);
+    //Ground plane given in the camera frame instead of looked up from tf (robot frame not needed)
+    void getPeopleCenter(PointCloudT::Ptr cloud, Eigen::VectorXf ground_coeffs, std::vector<Eigen::Vector3f>& center_list,
+                         std::vector<float>& confidence_list);
+    //Compact pipeline: the GroundBasedPeopleDetectionApp::compute stages on a CompactCloud cropped to getCropRange()
+    bool getPeopleCenter(const CompactCloud &cloud, std::vector<Eigen::Vector3f>& center_list, std::vector<float>& confidence_list);
+    void getPeopleCenter(const CompactCloud &cloud, Eigen::VectorXf ground_coeffs, std::vector<Eigen::Vector3f>& center_list,
+                         std::vector<float>& confidence_list);
+    float getCropRange(void);
+    //Threads of the compact pipeline voxel grid (<= 0: one per core), started on the first frame
+    void setDownsampleThreads(int threads);
+    //Compact pipeline candidates from a top-down height map instead of Euclidean clustering + head subclustering
+    void setHeightMapCandidates(bool enable, float cell_size = DEFAULT_HEIGHT_MAP_CELL_SIZE);
     void addNewCloudToViewer(PointCloudT::Ptr cloud, pcl::visualization::PCLVisualizer::Ptr viewer_obj);
     void drawPeopleDetectBox(pcl::visualization::PCLVisualizer::Ptr viewer_obj);
     void setRobotFrame(std::string camera_link,std::string robot_base_link);
+    //Start buffering tf for the ground plane: call at node start. Tools giving ground coefficients run without it
+    void initTransformListener(void);
 
 
     //Static Methods
@@ -71,21 +102,37 @@ public:
 
 private:
     //Private Parameters
-    tf::TransformListener listener;
+    boost::shared_ptr<tf::TransformListener> listener;
+    Eigen::VectorXf last_ground_coeffs; //last ground plane from tf, used while tf is not available
+    bool ground_coeffs_available;
     Eigen::Matrix3f rgb_intrinsics_matrix;
     pcl::people::PersonClassifier<pcl::RGB> person_classifier;
     pcl::people::GroundBasedPeopleDetectionApp<PointT> people_detector;
     std::vector<pcl::people::PersonCluster<PointT> > clusters;   // vector containing persons clusters
+    CompactCloudFilter compact_filter;
+    boost::shared_ptr<VoxelDownsampler> downsampler;
+    int downsample_threads;
+    HeightMapDetector height_map;
+    bool height_map_candidates;
+    std::vector<compact_point> filtered_points; //compact pipeline buffers
+    std::vector<compact_point> no_ground_points;
+    std::vector<std::vector<int> > compact_clusters;
+    std::vector<pcl::PointIndices> cluster_indices;
+    PointCloudT::Ptr no_ground_cloud;
     //std::vector<Eigen::Vector3f> pp_center_list; //buffer for newly detected ppl center
     double min_confidence;
     double min_height;
     double max_height;
     double detect_range;
     double heads_minimum_distance;
+    double voxel_size;
     bool ui_enable;
 
     //Private Functions
-    Eigen::VectorXf getGroundCoeffs();
+    bool getGroundCoeffs(ros::Time stamp, Eigen::VectorXf &ground_coeffs);
+    void computeCompact(const CompactCloud &cloud, Eigen::VectorXf ground_coeffs);
+    void selectPeopleCenters(std::vector<Eigen::Vector3f>& center_list, std::vector<float>& confidence_list);
+    void loadClassifier(std::string svm_filename, std::string svm_cache_filename);
 
 
 };
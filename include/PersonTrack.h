@@ -0,0 +1,42 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_PERSON_TRACK_H
+#define PEOPLE_DETECTION_PERSON_TRACK_H
+
+#include <Eigen/Dense>
+
+
+#define SINGLE_NEAREST_NEIGHBOR_TRACKER 0
+#define MULTI_NEAREST_NEIGHBOR_TRACKER 1
+#define KALMAN_TRACKER 2
+
+#define UPDATE_NORMAL 0
+#define UPDATE_WITH_FRAME_COUNT 1
+
+#define DEFAULT_OUT_OF_TRACK_CONDITION 5
+#define DEFAULT_GET_IN_TRACK_CONDITION 2
+#define DEFAULT_GET_IN_TRACK_CHECK_FRAME 3
+
+#define DEFAULT_VELOCITY_SMOOTHING 0.5
+#define DEFAULT_MAX_VELOCITY_GAP 1.0
+#define DEFAULT_VARIANCE_SMOOTHING 0.3
+#define DEFAULT_INITIAL_POSITION_STDDEV 0.1
+
+typedef struct{
+    Eigen::Vector3f points;
+    Eigen::Vector3f velocity; //m/s, estimated between measured frames
+    double stamp; //sensor time (sec) of the last measurement
+    Eigen::Vector3f variance; //per axis position variance from the prediction residuals
+    float confidence; //detector confidence of the last measurement
+    Eigen::Vector3f color;
+    int id;
+    int framesage;
+    int incount;
+    int outcount;
+    bool istrack;
+}person;
+
+
+#endif //PEOPLE_DETECTION_PERSON_TRACK_H
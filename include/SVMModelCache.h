@@ -0,0 +1,49 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_SVM_MODEL_CACHE_H
+#define PEOPLE_DETECTION_SVM_MODEL_CACHE_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <pcl/point_types.h>
+#include <pcl/people/person_classifier.h>
+
+
+#define SVM_MODEL_CACHE_MAGIC 0x56535044 //"PDSV"
+#define SVM_MODEL_CACHE_VERSION 2
+
+#define SVM_MODEL_CACHE_OK 0
+#define SVM_MODEL_CACHE_MISSING 1
+#define SVM_MODEL_CACHE_INVALID 2
+#define SVM_MODEL_CACHE_STALE 3 //converted from another model than the source file
+
+//Binary SVM model file: header followed by weight_count float weights, native byte order.
+//Written offline (svm_model_converter) and memory mapped at startup instead of parsing the YAML model.
+typedef struct{
+    uint32_t magic;
+    uint32_t version;
+    int32_t window_height;
+    int32_t window_width;
+    float offset;
+    uint32_t weight_count;
+    uint64_t source_size; //YAML model the cache was converted from
+    uint64_t source_hash; //FNV-1a of its content
+}svm_model_cache_header;
+
+class SVMModelCache
+{
+    public:
+        //source_filename: YAML model classifier was loaded from
+        static bool save(std::string filename, pcl::people::PersonClassifier<pcl::RGB> &classifier, std::string source_filename);
+        //SVM_MODEL_CACHE_OK or the reason the cache is not used, classifier is then left untouched.
+        //A source file that cannot be read is not checked
+        static int load(std::string filename, pcl::people::PersonClassifier<pcl::RGB> &classifier, std::string source_filename);
+        //Size and FNV-1a hash of the file content, false if it cannot be read
+        static bool sourceSignature(std::string filename, uint64_t &size, uint64_t &hash);
+};
+
+
+#endif //PEOPLE_DETECTION_SVM_MODEL_CACHE_H
@@ -0,0 +1,123 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_SHARDED_PEOPLE_TRACKER_H
+#define PEOPLE_DETECTION_SHARDED_PEOPLE_TRACKER_H
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <Eigen/Dense>
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <PeopleTracker.h>
+#include <TrackHistory.h>
+#include <TrackIdAllocator.h>
+
+
+#define DEFAULT_SHARD_TILE_SIZE 4.0
+#define DEFAULT_SHARD_AXIS_0 0 //camera x
+#define DEFAULT_SHARD_AXIS_1 2 //camera z
+
+typedef std::pair<int, int> shard_tile;
+
+typedef struct{
+    shard_tile tile;
+    PeopleTracker *tracker;
+    std::vector<person> world;
+    std::vector<Eigen::Vector3f> centers;
+    std::vector<float> confidences;
+}tracker_shard;
+
+//Multi NN tracking split over square tiles of the floor, one PeopleTracker per tile, tiles run on a pool of threads.
+//Tracks and detections go to the tile of their position, except when a track and a detection are closer than the
+//track distance across a tile edge: their connected component (track-detection pairs within the track distance) is
+//handed whole to the smallest tile of its tracks. The greedy Multi NN match of a component does not depend on the
+//rest of the frame, so every track gets the same detection (same points and counters) as with one PeopleTracker;
+//the list order and the ids of new tracks differ. The sequential pre-pass and the merge in tile order make the
+//result independent of the thread count:
+//shards create tracks with placeholder ids (FIRST_PLACEHOLDER_TRACK_ID up, per tile tracker) and the merge gives them
+//real ids in tile order, so ids are the same for any thread count and scheduling.
+//SINGLE_NEAREST_NEIGHBOR_TRACKER follows one person and is not sharded.
+class ShardedPeopleTracker
+{
+    public:
+        //threads <= 0: one per core
+        ShardedPeopleTracker(int threads = 0);
+        ~ShardedPeopleTracker();
+        void setTileSize(float size);
+        //Axes of the camera frame spanning the floor (x = 0, y = 1, z = 2)
+        void setTileAxes(int axis0, int axis1);
+        void setListUpdateConstraints(int getin, int getincheck, int getout);
+        void setTrackThreshold(float distTH);
+        void setSingleTrackResetDistance(float distTH);
+        void setVelocitySmoothing(float alpha);
+        void setFrameStamp(double stamp);
+        void setFrameConfidences(const std::vector<float> &confidences);
+        void resetTrackID(void);
+        TrackHistory& getTrackHistory(void);
+        void setHistoryCapacity(int max_tracks, int samples_per_track);
+        int getThreadCount(void);
+        //Tiles processed by the last trackPeople call
+        int getShardCount(void);
+        void trackPeople(std::vector<person> &global_track_list, const std::vector<Eigen::Vector3f> &new_center_list,
+                         int algorithm = MULTI_NEAREST_NEIGHBOR_TRACKER, int list_update_method = UPDATE_NORMAL);
+
+    private:
+        shard_tile getTile(const Eigen::Vector3f &points);
+        bool inBoundaryBand(const Eigen::Vector3f &points, const shard_tile &tile);
+        int getShard(const shard_tile &tile);
+        PeopleTracker* getTileTracker(const shard_tile &tile);
+        void configureTracker(PeopleTracker &tracker);
+        void assignShards(const std::vector<person> &world, const std::vector<Eigen::Vector3f> &new_center_list);
+        int findRoot(int element);
+        void linkElements(int a, int b);
+        void runShards(void);
+        void processShards(void);
+        void workerLoop(void);
+        void recordHistory(const std::vector<person> &world);
+        void assignNewIds(std::vector<person> &world);
+
+        float tile_size;
+        int axis[2];
+        int person_get_in_track_condition;
+        int get_in_track_check_frame;
+        int person_out_of_track_condition;
+        float track_distance_threshold;
+        float single_track_reset_distance;
+        float velocity_smoothing;
+        double frame_stamp;
+        std::vector<float> frame_confidences;
+        int algorithm;
+        int list_update_method;
+
+        boost::shared_ptr<TrackIdAllocator> id_allocator;
+        PeopleTracker single_tracker;
+        std::map<shard_tile, boost::shared_ptr<PeopleTracker> > tile_trackers; //persistent, one per visited tile
+        std::vector<tracker_shard> shards; //reused between frames, shard_count in use
+        int shard_count;
+        std::map<shard_tile, int> shard_lookup; //tile -> shard of the current frame, in tile order
+        //Pre-pass components, elements: tracks then detections of the frame
+        std::map<shard_tile, std::vector<int> > tile_tracks;
+        std::vector<shard_tile> element_tiles;
+        std::vector<int> element_roots;
+        std::vector<shard_tile> component_tiles;
+        std::vector<char> component_has_track;
+        TrackHistory track_history;
+        std::vector<int> alive_ids;
+
+        //Worker pool: the calling thread is one of the thread_count workers
+        int thread_count;
+        boost::thread_group workers;
+        boost::shared_ptr<boost::barrier> start_barrier;
+        boost::shared_ptr<boost::barrier> done_barrier;
+        boost::atomic<int> next_shard;
+        boost::atomic<bool> stopping;
+};
+
+
+#endif //PEOPLE_DETECTION_SHARDED_PEOPLE_TRACKER_H
@@ -0,0 +1,84 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_SYNTHETIC_CROWD_H
+#define PEOPLE_DETECTION_SYNTHETIC_CROWD_H
+
+#include <vector>
+#include <Eigen/Dense>
+#include <pcl/point_types.h>
+#include <pcl/point_cloud.h>
+
+
+#define DEFAULT_SYNTHETIC_WIDTH 640
+#define DEFAULT_SYNTHETIC_HEIGHT 480
+#define DEFAULT_SYNTHETIC_CAMERA_HEIGHT 1.0
+#define DEFAULT_SYNTHETIC_MAX_RANGE 8.0
+#define DEFAULT_SYNTHETIC_HEAD_RADIUS 0.11
+
+//Person body: vertical cylinder from the ground to the shoulders plus a head sphere.
+//Positions are on the ground plane of the camera optical frame (x right, z forward), y is ignored.
+typedef struct{
+    int id;
+    float height;
+    float radius;
+    float speed; //m/s along the waypoints, back and forth
+    std::vector<Eigen::Vector3f> waypoints;
+    Eigen::Vector3f color; //shirt rgb 0-255
+}synthetic_person;
+
+typedef struct{
+    Eigen::Vector3f min_corner;
+    Eigen::Vector3f max_corner;
+    Eigen::Vector3f color;
+}synthetic_box;
+
+typedef struct{
+    int id;
+    Eigen::Vector3f center; //camera frame, half height (like PersonCluster::getTCenter)
+}synthetic_ground_truth;
+
+//Ray cast organized PointXYZRGBA clouds of a level camera at camera_height above a flat floor
+//with boxes as clutter and people walking scripted trajectories. Same intrinsics as the node (IntrinsicParamtoMatrix3f).
+class SyntheticCrowd
+{
+    public:
+        SyntheticCrowd(Eigen::Matrix3f rgb_intrinsics_matrix, int width = DEFAULT_SYNTHETIC_WIDTH, int height = DEFAULT_SYNTHETIC_HEIGHT,
+                       float camera_height = DEFAULT_SYNTHETIC_CAMERA_HEIGHT);
+        void setMaxRange(float range);
+        //Depth noise stddev = noise_coeff*z^2 (Kinect like 0.0015), 0 for exact depth
+        void setDepthNoise(float noise_coeff);
+        void addPerson(const synthetic_person &p);
+        void addBox(const synthetic_box &b);
+        void clear(void);
+        //n people with random size, speed and waypoints inside x in [-x_range, x_range], z in [z_min, z_max]
+        void addRandomCrowd(int n_people, float x_range, float z_min, float z_max, unsigned int seed);
+        void addRandomClutter(int n_boxes, float x_range, float z_min, float z_max, unsigned int seed);
+
+        void generate(double t, pcl::PointCloud<pcl::PointXYZRGBA> &cloud, std::vector<synthetic_ground_truth> &ground_truth);
+        Eigen::Vector3f getPersonPosition(const synthetic_person &p, double t);
+        //Floor in the camera frame, for PeopleDetector::getPeopleCenter
+        Eigen::VectorXf getGroundCoeffs(void);
+
+    private:
+        float rayPerson(const Eigen::Vector3f &ray, const synthetic_person &p, const Eigen::Vector3f &position, bool &head);
+        float rayBox(const Eigen::Vector3f &ray, const synthetic_box &b);
+        float gaussianNoise(void);
+        void setPoint(pcl::PointXYZRGBA &pt, const Eigen::Vector3f &ray, float t, const Eigen::Vector3f &color);
+
+        Eigen::Matrix3f intrinsics;
+        int width;
+        int height;
+        float camera_height;
+        float max_range;
+        float noise_coeff;
+        unsigned int noise_seed;
+        std::vector<synthetic_person> people;
+        std::vector<synthetic_box> boxes;
+        std::vector<Eigen::Vector3f> rays; //unit z pixel rays, row major
+        std::vector<float> depth_buffer;
+};
+
+
+#endif //PEOPLE_DETECTION_SYNTHETIC_CROWD_H
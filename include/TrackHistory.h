@@ -0,0 +1,54 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_TRACK_HISTORY_H
+#define PEOPLE_DETECTION_TRACK_HISTORY_H
+
+#include <vector>
+#include <Eigen/Dense>
+#include <boost/thread/mutex.hpp>
+
+
+#define DEFAULT_HISTORY_MAX_TRACKS 64
+#define DEFAULT_HISTORY_CAPACITY 150
+
+typedef struct{
+    double stamp;
+    Eigen::Vector3f points;
+}track_sample;
+
+//Fixed capacity ring buffer of measured positions per track id.
+//All buffers are slots of one pool allocated in setCapacity, so recording does not allocate.
+class TrackHistory
+{
+    public:
+        TrackHistory(int max_tracks = DEFAULT_HISTORY_MAX_TRACKS, int capacity = DEFAULT_HISTORY_CAPACITY);
+        //Reallocate the pool: drops all recorded history
+        void setCapacity(int max_tracks, int capacity);
+        void addSample(int id, double stamp, const Eigen::Vector3f &points);
+        //Release the slots of every id not in alive_ids
+        void retainTracks(const std::vector<int> &alive_ids);
+        void clear(void);
+
+        //Samples of track id with stamp >= since, oldest first. Return false if id has no history
+        bool getTrack(int id, double since, std::vector<track_sample> &samples);
+        //Ids of tracks with at least one sample within radius of center and stamp >= since
+        void getTracksWithinRadius(const Eigen::Vector3f &center, float radius, double since, std::vector<int> &ids);
+
+    private:
+        int findSlot(int id);
+        int allocateSlot(int id);
+        const track_sample& sampleAt(int slot, int i); //i = 0 is the oldest sample in the slot
+
+        boost::mutex history_mutex;
+        int max_tracks;
+        int capacity;
+        std::vector<track_sample> pool; //max_tracks*capacity samples, slot s starts at s*capacity
+        std::vector<int> slot_id; //-1 = free
+        std::vector<int> slot_head; //index of the next write in the slot
+        std::vector<int> slot_size;
+};
+
+
+#endif //PEOPLE_DETECTION_TRACK_HISTORY_H
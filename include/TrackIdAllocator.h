@@ -0,0 +1,32 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_TRACK_ID_ALLOCATOR_H
+#define PEOPLE_DETECTION_TRACK_ID_ALLOCATOR_H
+
+#include <boost/atomic.hpp>
+
+
+#define FIRST_TRACK_ID 1
+#define FIRST_PLACEHOLDER_TRACK_ID (-1073741824) //negative: never a real id
+
+//Track ids shared by several PeopleTracker instances (e.g. the shards of ShardedPeopleTracker).
+//allocate() is a single atomic fetch_add: safe from any number of threads without a lock.
+class TrackIdAllocator
+{
+    public:
+        TrackIdAllocator(int first_id = FIRST_TRACK_ID);
+        int allocate(void);
+        //Next id allocate() returns, without taking it
+        int peek(void);
+        //Back to first_id
+        void reset(void);
+
+    private:
+        int first_id;
+        boost::atomic<int> next_id;
+};
+
+
+#endif //PEOPLE_DETECTION_TRACK_ID_ALLOCATOR_H
@@ -0,0 +1,77 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_TRACKER_CONTEXT_H
+#define PEOPLE_DETECTION_TRACKER_CONTEXT_H
+
+#include <cstdlib>
+#include <stdlib.h>
+#include <vector>
+#include <cmath>
+#include <Eigen/Dense>
+#include <boost/shared_ptr.hpp>
+#include <TrackHistory.h>
+#include <TrackIdAllocator.h>
+#include <PersonTrack.h>
+
+
+//Everything a tracker keeps between frames apart from the track list: parameters, ids, colors, history and the
+//frame inputs. The association and lifecycle policies (TrackerPolicies.h) create and update persons through it.
+class TrackerContext
+{
+    public:
+        TrackerContext();
+        //Use this before track: if wish to use list_update_method = UPDATE_WITH_FRAME_COUNT
+        void setListUpdateConstraints(int getin, int getincheck, int getout);
+        void setTrackThreshold(float distTH);
+        void setSingleTrackResetDistance(float distTH);
+        //Use this before track: sensor time (sec) of the frame given to the next trackPeople call
+        void setFrameStamp(double stamp);
+        //False (alpha kept) if alpha is not in (0,1]
+        bool setVelocitySmoothing(float alpha);
+        float getVelocitySmoothing(void) const { return this->velocity_smoothing; }
+        //Use this before track: detector confidence of each center given to the next trackPeople call
+        void setFrameConfidences(const std::vector<float> &confidences);
+        void resetTrackID(void);
+        //Share ids with other trackers (sharded tracking): ids stay unique across all of them
+        void setIdAllocator(boost::shared_ptr<TrackIdAllocator> allocator);
+        //Measured positions of the tracks, recorded by trackPeople (camera frame, sensor time)
+        TrackHistory& getTrackHistory(void);
+        void setHistoryCapacity(int max_tracks, int samples_per_track);
+        //Off when the owner records the history of the merged list itself (ShardedPeopleTracker)
+        void setRecordHistory(bool enable);
+        static Eigen::Vector3f extrapolatePosition(const person &p, double stamp, double max_horizon);
+
+        //Used by the policies
+        float getTrackThreshold(void) const { return this->track_distance_threshold; }
+        float getSingleTrackResetDistance(void) const { return this->single_track_reset_distance; }
+        int getOutOfTrackCondition(void) const { return this->person_out_of_track_condition; }
+        int getInTrackCheckFrame(void) const { return this->get_in_track_check_frame; }
+        void beginFrame(const std::vector<Eigen::Vector3f> &new_center_list);
+        void endFrame(const std::vector<person> &world);
+        person createNewPerson(const Eigen::Vector3f &center_points, bool id_increment = true);
+        void updatePersonMeasurement(person &p, const Eigen::Vector3f &center_points);
+
+    private:
+        float getFrameConfidence(const Eigen::Vector3f &center_points);
+        Eigen::Vector3f generateTrackerColor();
+
+        boost::shared_ptr<TrackIdAllocator> id_allocator;
+        int person_out_of_track_condition;
+        int person_get_in_track_condition;
+        int get_in_track_check_frame;
+        float track_distance_threshold;
+        float single_track_reset_distance;
+        float velocity_smoothing;
+        unsigned int color_seed;
+        double frame_stamp;
+        std::vector<Eigen::Vector3f> frame_centers;
+        std::vector<float> frame_confidences;
+        TrackHistory track_history;
+        bool record_history;
+        std::vector<int> alive_ids; //buffer for endFrame
+};
+
+
+#endif //PEOPLE_DETECTION_TRACKER_CONTEXT_H
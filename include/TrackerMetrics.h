@@ -0,0 +1,37 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_TRACKER_METRICS_H
+#define PEOPLE_DETECTION_TRACKER_METRICS_H
+
+#include <cmath>
+#include <Eigen/Dense>
+
+
+//Distance metrics of the trackers: static float distance(const Eigen::Vector3f&, const Eigen::Vector3f&)
+
+struct EuclideanDistance
+{
+    static float distance(const Eigen::Vector3f &A, const Eigen::Vector3f &B)
+    {
+        float delx2 = (A(0)-B(0))*(A(0)-B(0));
+        float dely2 = (A(1)-B(1))*(A(1)-B(1));
+        float delz2 = (A(2)-B(2))*(A(2)-B(2));
+        return sqrt(delx2+dely2+delz2);
+    }
+};
+
+//Camera optical frame: x-z is the floor, the height of the center (y) is ignored
+struct GroundPlaneDistance
+{
+    static float distance(const Eigen::Vector3f &A, const Eigen::Vector3f &B)
+    {
+        float delx2 = (A(0)-B(0))*(A(0)-B(0));
+        float delz2 = (A(2)-B(2))*(A(2)-B(2));
+        return sqrt(delx2+delz2);
+    }
+};
+
+
+#endif //PEOPLE_DETECTION_TRACKER_METRICS_H
@@ -0,0 +1,277 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_TRACKER_POLICIES_H
+#define PEOPLE_DETECTION_TRACKER_POLICIES_H
+
+#include <algorithm>
+#include <vector>
+#include <Eigen/Dense>
+#include <TrackerContext.h>
+#include <TrackerMetrics.h>
+
+
+//Policies of BasicPeopleTracker<Association, Lifecycle, Metric>.
+//Metric:      static float distance(const Eigen::Vector3f&, const Eigen::Vector3f&)
+//Lifecycle:   beginFrame(), lostTrack(context, world, index) during association, endFrame(context, world)
+//Association: template<class Metric, class Lifecycle> associate(context, lifecycle, world, new_center_list)
+//Anything with these members can be plugged in, the runtime front-end (PeopleTracker) only knows the ones below.
+
+//Lifecycle---------------------------------------------------------------
+
+//Every person is tracked right away, a lost person is removed in the same frame
+struct NormalLifecycle
+{
+    std::vector<int> lost; //indices into world, ascending
+
+    void beginFrame(void)
+    {
+        this->lost.clear();
+    }
+
+    void lostTrack(TrackerContext &context, std::vector<person> &world, int index)
+    {
+        this->lost.push_back(index);
+    }
+
+    void endFrame(TrackerContext &context, std::vector<person> &world)
+    {
+        for(int i=0; i < world.size(); i++)
+            world[i].istrack = true;
+        if(this->lost.empty())
+            return;
+        int kept = 0;
+        int next_lost = 0;
+        for(int i=0; i < world.size(); i++)
+        {
+            if((next_lost < this->lost.size()) && (this->lost[next_lost] == i))
+            {
+                next_lost++;
+                continue;
+            }
+            if(kept != i)
+                world[kept] = world[i];
+            kept++;
+        }
+        world.resize(kept);
+    }
+};
+
+//New persons are confirmed after get_in_check frames if missed fewer than get_in_condition times,
+//tracked persons are removed after out_track_condition misses
+struct FrameCountLifecycle
+{
+    void beginFrame(void)
+    {
+    }
+
+    void lostTrack(TrackerContext &context, std::vector<person> &world, int index)
+    {
+        person &p = world[index];
+        if(p.istrack)
+            --p.outcount;
+        else
+            --p.incount;
+    }
+
+    void endFrame(TrackerContext &context, std::vector<person> &world)
+    {
+        //Remove or Move in Person, kept persons are compacted in order
+        int kept = 0;
+        for(int i=0; i < world.size(); i++)
+        {
+            person &p = world[i];
+            //Lost track -> Remove This Person
+            if(p.outcount <= 0)
+                continue;
+            if(p.istrack == false)
+            {
+                if(p.framesage >= context.getInTrackCheckFrame())
+                {
+                    //Missed too often while new
+                    if(p.incount <= 0)
+                        continue;
+                    p.istrack = true;
+                    p.outcount = context.getOutOfTrackCondition();
+                }
+                else
+                {
+                    p.framesage++;
+                }
+            }
+            else
+            {
+                p.framesage++;
+            }
+            if(kept != i)
+                world[kept] = p;
+            kept++;
+        }
+        world.resize(kept);
+    }
+};
+
+//Association-------------------------------------------------------------
+
+//Follow one person: the closest center to the last position, or (no track yet) to the front of the camera
+struct SingleNNAssociation
+{
+    template<class Metric, class Lifecycle>
+    void associate(TrackerContext &context, Lifecycle &lifecycle, std::vector<person> &world, const std::vector<Eigen::Vector3f> &new_center_list)
+    {
+        if(!world.empty())
+        {
+            int index = -1;
+            float min = 9999.0f;
+            for(int i = 0 ; i < new_center_list.size(); i++)
+            {
+                float tmp = Metric::distance(world[0].points, new_center_list[i]);
+                if((tmp < min) && (tmp < context.getTrackThreshold()))
+                {
+                    min = tmp;
+                    index = i;
+                }
+            }
+            if(index >= 0)
+                context.updatePersonMeasurement(world[0], new_center_list[index]);
+            else
+                lifecycle.lostTrack(context, world, 0);
+        }
+        else
+        {
+            Eigen::Vector3f origin;
+            origin << 1.0, 0.0, 1.0;
+            int index = -1;
+            float min = 9999.0f;
+            for(int i = 0 ; i < new_center_list.size(); i++)
+            {
+                float tmp = Metric::distance(origin, new_center_list[i]);
+                if((tmp < min) && (tmp <= context.getSingleTrackResetDistance()))
+                {
+                    min = tmp;
+                    index = i;
+                }
+            }
+            if(index >= 0)
+                world.push_back(context.createNewPerson(new_center_list[index], false));
+        }
+    }
+};
+
+//Greedy global nearest neighbor: the closest (track, center) pair is matched first while closer than the track
+//distance, the remaining centers become new persons (closest to a lost track first) and the remaining tracks are lost.
+//Same result as repeatedly taking the minimum of the distance table, with one table and one sort per frame.
+struct MultiNNAssociation
+{
+    typedef struct{
+        float distance;
+        int row; //track
+        int col; //center
+    }nn_pair;
+
+    static bool pairLess(const nn_pair &a, const nn_pair &b)
+    {
+        if(a.distance != b.distance)
+            return a.distance < b.distance;
+        if(a.row != b.row)
+            return a.row < b.row;
+        return a.col < b.col;
+    }
+
+    std::vector<nn_pair> pairs;
+    std::vector<nn_pair> new_pairs;
+    std::vector<char> row_used;
+    std::vector<char> col_used;
+
+    template<class Metric, class Lifecycle>
+    void associate(TrackerContext &context, Lifecycle &lifecycle, std::vector<person> &world, const std::vector<Eigen::Vector3f> &new_center_list)
+    {
+        int rows = world.size();
+        int cols = new_center_list.size();
+        if(rows == 0)
+        {
+            //No one is tracked from the last frame re_init tracker list
+            for(int i=0; i < cols; i++)
+                world.push_back(context.createNewPerson(new_center_list[i]));
+            return;
+        }
+
+        this->row_used.assign(rows, 0);
+        this->col_used.assign(cols, 0);
+        float threshold = context.getTrackThreshold();
+        this->pairs.clear();
+        for(int r=0; r < rows; r++)
+        {
+            for(int c=0; c < cols; c++)
+            {
+                nn_pair pair;
+                pair.distance = Metric::distance(world[r].points, new_center_list[c]);
+                if(pair.distance < threshold)
+                {
+                    pair.row = r;
+                    pair.col = c;
+                    this->pairs.push_back(pair);
+                }
+            }
+        }
+        std::sort(this->pairs.begin(), this->pairs.end(), pairLess);
+
+        int matched = 0;
+        for(int k=0; k < this->pairs.size(); k++)
+        {
+            const nn_pair &pair = this->pairs[k];
+            if(this->row_used[pair.row] || this->col_used[pair.col])
+                continue;
+            this->row_used[pair.row] = 1;
+            this->col_used[pair.col] = 1;
+            context.updatePersonMeasurement(world[pair.row], new_center_list[pair.col]);
+            //Refresh outcount condition
+            world[pair.row].outcount = context.getOutOfTrackCondition();
+            matched++;
+        }
+
+        if(matched < rows)
+        {
+            //Each remaining center by its closest remaining track
+            this->new_pairs.clear();
+            for(int c=0; c < cols; c++)
+            {
+                if(this->col_used[c])
+                    continue;
+                nn_pair best;
+                best.col = c;
+                best.row = -1;
+                for(int r=0; r < rows; r++)
+                {
+                    if(this->row_used[r])
+                        continue;
+                    float distance = Metric::distance(world[r].points, new_center_list[c]);
+                    if((best.row < 0) || (distance < best.distance))
+                    {
+                        best.distance = distance;
+                        best.row = r;
+                    }
+                }
+                this->new_pairs.push_back(best);
+            }
+            std::sort(this->new_pairs.begin(), this->new_pairs.end(), pairLess);
+            for(int k=0; k < this->new_pairs.size(); k++)
+                world.push_back(context.createNewPerson(new_center_list[this->new_pairs[k].col]));
+        }
+        else
+        {
+            //Every track is matched: the remaining centers are new people
+            for(int c=0; c < cols; c++)
+                if(!this->col_used[c])
+                    world.push_back(context.createNewPerson(new_center_list[c]));
+        }
+
+        for(int r=0; r < rows; r++)
+            if(!this->row_used[r])
+                lifecycle.lostTrack(context, world, r);
+    }
+};
+
+
+#endif //PEOPLE_DETECTION_TRACKER_POLICIES_H
@@ -0,0 +1,78 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#ifndef PEOPLE_DETECTION_VOXEL_DOWNSAMPLER_H
+#define PEOPLE_DETECTION_VOXEL_DOWNSAMPLER_H
+
+#include <stdint.h>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <CompactCloud.h>
+
+
+#define DEFAULT_VOXEL_MIN_CHUNK 16384 //points per chunk at least: small clouds use fewer threads
+#define DEFAULT_VOXEL_TABLE_SIZE 4096 //initial slots of a chunk table, doubled at half load
+
+typedef struct{
+    int64_t key; //voxel index z, y, x packed: key order is the pcl::VoxelGrid output order
+    int64_t sum[3]; //mm
+    uint32_t color[3];
+    int count; //0: empty slot
+}voxel_accumulator;
+
+//Open addressing table of the voxels of one chunk, kept between frames
+typedef struct{
+    std::vector<voxel_accumulator> slots;
+    std::vector<int> used; //occupied slots
+    int bits;
+}voxel_table;
+
+//Voxel grid filter of compact points on a pool of threads: the cloud is cut in contiguous chunks, each accumulated into
+//its own hash table of voxel sums, the tables are merged in voxel order. Sums are integer so the result is the same as
+//CompactCloudFilter::voxelDownsample for any thread count.
+class VoxelDownsampler
+{
+    public:
+        //threads <= 0: one per core
+        VoxelDownsampler(int threads = 0);
+        ~VoxelDownsampler();
+        int getThreadCount(void);
+        void downsample(const std::vector<compact_point> &in, float leaf_size, std::vector<compact_point> &out);
+
+    private:
+        static int64_t voxelKey(int64_t ix, int64_t iy, int64_t iz);
+        static void clearTable(voxel_table &table);
+        static void growTable(voxel_table &table);
+        static voxel_accumulator& findSlot(voxel_table &table, int64_t key);
+        static bool accumulatorLess(const voxel_accumulator &a, const voxel_accumulator &b)
+        {
+            return a.key < b.key;
+        }
+        void accumulateChunk(int chunk);
+        void runChunks(void);
+        void processChunks(void);
+        void workerLoop(void);
+
+        //Frame input, read by the workers
+        const std::vector<compact_point> *input;
+        float inverse_leaf;
+        int chunk_count;
+        int chunk_size;
+        std::vector<voxel_table> tables; //one per chunk
+        std::vector<voxel_accumulator> merged;
+
+        //Worker pool: the calling thread is one of the thread_count workers
+        int thread_count;
+        boost::thread_group workers;
+        boost::shared_ptr<boost::barrier> start_barrier;
+        boost::shared_ptr<boost::barrier> done_barrier;
+        boost::atomic<int> next_chunk;
+        boost::atomic<bool> stopping;
+};
+
+
+#endif //PEOPLE_DETECTION_VOXEL_DOWNSAMPLER_H
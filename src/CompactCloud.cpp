@@ -0,0 +1,377 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <CompactCloud.h>
+#include <string.h>
+#include <algorithm>
+
+
+//CompactCloud--------------------------------------------------------------
+
+CompactCloud::CompactCloud():
+        image(new pcl::PointCloud<pcl::RGB>)
+{
+    this->stamp = 0;
+}
+
+void CompactCloud::reserve(int width, int height)
+{
+    this->points.reserve(width*height);
+    this->image->points.reserve(width*height);
+}
+
+bool CompactCloud::fromROSMsg(const sensor_msgs::PointCloud2 &msg, float max_range)
+{
+    int x_offset = -1;
+    int y_offset = -1;
+    int z_offset = -1;
+    int rgb_offset = -1;
+    for(int i=0; i < msg.fields.size(); i++)
+    {
+        const sensor_msgs::PointField &field = msg.fields[i];
+        bool is_float = (field.datatype == sensor_msgs::PointField::FLOAT32);
+        if((field.name == "x") && is_float)
+            x_offset = field.offset;
+        else if((field.name == "y") && is_float)
+            y_offset = field.offset;
+        else if((field.name == "z") && is_float)
+            z_offset = field.offset;
+        else if((field.name == "rgb") || (field.name == "rgba"))
+            rgb_offset = field.offset;
+    }
+    if((x_offset < 0) || (y_offset < 0) || (z_offset < 0))
+        return false;
+    //Every read below must stay inside its point and its row: a malformed header would read past the data
+    if(msg.is_bigendian)
+        return false;
+    if(((uint64_t)x_offset + sizeof(float) > msg.point_step) || ((uint64_t)y_offset + sizeof(float) > msg.point_step) ||
+       ((uint64_t)z_offset + sizeof(float) > msg.point_step))
+        return false;
+    if((rgb_offset >= 0) && ((uint64_t)rgb_offset + 3 > msg.point_step))
+        return false;
+    if((uint64_t)msg.width*msg.point_step > msg.row_step)
+        return false;
+    if((uint64_t)msg.row_step*msg.height > msg.data.size())
+        return false;
+    if(max_range > COMPACT_MAX_RANGE)
+        max_range = COMPACT_MAX_RANGE;
+
+    this->stamp = msg.header.stamp.toNSec()/1000ull;
+    this->points.clear();
+    this->image->width = msg.width;
+    this->image->height = msg.height;
+    this->image->is_dense = true;
+    this->image->points.resize(msg.width*msg.height);
+    //One pass over the message: the full size PointXYZRGBA cloud is never built
+    for(int v=0; v < msg.height; v++)
+    {
+        const uint8_t *data = &msg.data[v*msg.row_step];
+        pcl::RGB *pixel = &this->image->points[v*msg.width];
+        for(int u=0; u < msg.width; u++, data += msg.point_step)
+        {
+            float x, y, z;
+            memcpy(&x, data + x_offset, sizeof(float));
+            memcpy(&y, data + y_offset, sizeof(float));
+            memcpy(&z, data + z_offset, sizeof(float));
+            //Packed as b, g, r, a bytes (little endian)
+            uint8_t r = 0, g = 0, b = 0;
+            if(rgb_offset >= 0)
+            {
+                b = data[rgb_offset];
+                g = data[rgb_offset + 1];
+                r = data[rgb_offset + 2];
+            }
+            pixel[u].r = r;
+            pixel[u].g = g;
+            pixel[u].b = b;
+            pixel[u].a = 255;
+
+            compact_point p;
+            if(this->cropPoint(x, y, z, max_range, p))
+            {
+                p.r = r;
+                p.g = g;
+                p.b = b;
+                this->points.push_back(p);
+            }
+        }
+    }
+    return true;
+}
+
+void CompactCloud::fromPCL(const pcl::PointCloud<pcl::PointXYZRGBA> &cloud, float max_range)
+{
+    if(max_range > COMPACT_MAX_RANGE)
+        max_range = COMPACT_MAX_RANGE;
+    this->stamp = cloud.header.stamp;
+    this->points.clear();
+    this->image->width = cloud.width;
+    this->image->height = cloud.height;
+    this->image->is_dense = true;
+    this->image->points.resize(cloud.points.size());
+    for(int i=0; i < cloud.points.size(); i++)
+    {
+        const pcl::PointXYZRGBA &pt = cloud.points[i];
+        pcl::RGB &pixel = this->image->points[i];
+        pixel.r = pt.r;
+        pixel.g = pt.g;
+        pixel.b = pt.b;
+        pixel.a = 255;
+
+        compact_point p;
+        if(this->cropPoint(pt.x, pt.y, pt.z, max_range, p))
+        {
+            p.r = pt.r;
+            p.g = pt.g;
+            p.b = pt.b;
+            this->points.push_back(p);
+        }
+    }
+}
+
+void CompactCloud::toPCL(const std::vector<compact_point> &points, pcl::PointCloud<pcl::PointXYZRGBA> &cloud)
+{
+    cloud.points.resize(points.size());
+    cloud.width = points.size();
+    cloud.height = 1;
+    cloud.is_dense = true;
+    for(int i=0; i < points.size(); i++)
+    {
+        const compact_point &p = points[i];
+        pcl::PointXYZRGBA &pt = cloud.points[i];
+        pt.x = toMeter(p.x);
+        pt.y = toMeter(p.y);
+        pt.z = toMeter(p.z);
+        pt.r = p.r;
+        pt.g = p.g;
+        pt.b = p.b;
+        pt.a = 255;
+    }
+}
+
+bool CompactCloud::cropPoint(float x, float y, float z, float max_range, compact_point &p)
+{
+    //NaN fails every comparison: dropped with the out of range points
+    if(!((z > 0.0f) && (z <= max_range) && (fabsf(x) <= COMPACT_MAX_RANGE) && (fabsf(y) <= COMPACT_MAX_RANGE)))
+        return false;
+    p.x = toMillimeter(x);
+    p.y = toMillimeter(y);
+    p.z = toMillimeter(z);
+    p.reserved = 0;
+    return true;
+}
+
+
+//CompactCloudFilter--------------------------------------------------------
+
+void CompactCloudFilter::voxelDownsample(const std::vector<compact_point> &in, float leaf_size, std::vector<compact_point> &out)
+{
+    out.clear();
+    if(in.empty())
+        return;
+    float inverse_leaf = 1.0f/(leaf_size*1000.0f);
+    int min_mm[3] = {in[0].x, in[0].y, in[0].z};
+    int max_mm[3] = {in[0].x, in[0].y, in[0].z};
+    for(int i=1; i < in.size(); i++)
+    {
+        const compact_point &p = in[i];
+        min_mm[0] = std::min(min_mm[0], (int)p.x);
+        min_mm[1] = std::min(min_mm[1], (int)p.y);
+        min_mm[2] = std::min(min_mm[2], (int)p.z);
+        max_mm[0] = std::max(max_mm[0], (int)p.x);
+        max_mm[1] = std::max(max_mm[1], (int)p.y);
+        max_mm[2] = std::max(max_mm[2], (int)p.z);
+    }
+    int64_t min_b[3], div_b[3];
+    for(int k=0; k < 3; k++)
+    {
+        min_b[k] = (int64_t)floorf(min_mm[k]*inverse_leaf);
+        div_b[k] = (int64_t)floorf(max_mm[k]*inverse_leaf) - min_b[k] + 1;
+    }
+
+    //Voxel index of every point, sorted: points of one voxel are contiguous
+    this->keyed.resize(in.size());
+    for(int i=0; i < in.size(); i++)
+    {
+        const compact_point &p = in[i];
+        int64_t ix = (int64_t)floorf(p.x*inverse_leaf) - min_b[0];
+        int64_t iy = (int64_t)floorf(p.y*inverse_leaf) - min_b[1];
+        int64_t iz = (int64_t)floorf(p.z*inverse_leaf) - min_b[2];
+        this->keyed[i].key = ix + iy*div_b[0] + iz*div_b[0]*div_b[1];
+        this->keyed[i].index = i;
+    }
+    std::sort(this->keyed.begin(), this->keyed.end(), keyLess);
+
+    int first = 0;
+    while(first < this->keyed.size())
+    {
+        int last = first;
+        int64_t sum[3] = {0, 0, 0};
+        uint32_t color[3] = {0, 0, 0};
+        while((last < this->keyed.size()) && (this->keyed[last].key == this->keyed[first].key))
+        {
+            const compact_point &p = in[this->keyed[last].index];
+            sum[0] += p.x;
+            sum[1] += p.y;
+            sum[2] += p.z;
+            color[0] += p.r;
+            color[1] += p.g;
+            color[2] += p.b;
+            last++;
+        }
+        int count = last - first;
+        compact_point centroid;
+        centroid.x = (int16_t)lrint((double)sum[0]/count);
+        centroid.y = (int16_t)lrint((double)sum[1]/count);
+        centroid.z = (int16_t)lrint((double)sum[2]/count);
+        centroid.r = color[0]/count;
+        centroid.g = color[1]/count;
+        centroid.b = color[2]/count;
+        centroid.reserved = 0;
+        out.push_back(centroid);
+        first = last;
+    }
+}
+
+int CompactCloudFilter::removePlane(const std::vector<compact_point> &in, Eigen::Vector4f &plane, float distance, int min_refit,
+                                    std::vector<compact_point> &out)
+{
+    out.clear();
+    int inliers = 0;
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d sum_sq = Eigen::Matrix3d::Zero();
+    for(int i=0; i < in.size(); i++)
+    {
+        const compact_point &p = in[i];
+        Eigen::Vector3f pt(CompactCloud::toMeter(p.x), CompactCloud::toMeter(p.y), CompactCloud::toMeter(p.z));
+        if(fabsf(plane.head<3>().dot(pt) + plane(3)) < distance)
+        {
+            Eigen::Vector3d ptd = pt.cast<double>();
+            sum += ptd;
+            sum_sq += ptd*ptd.transpose();
+            inliers++;
+        }
+        else
+        {
+            out.push_back(p);
+        }
+    }
+
+    if((inliers >= min_refit) && (inliers >= 3))
+    {
+        //Normal = smallest eigenvector of the inlier covariance (as SampleConsensusModelPlane::optimizeModelCoefficients)
+        Eigen::Vector3d centroid = sum/inliers;
+        Eigen::Matrix3d covariance = sum_sq/inliers - centroid*centroid.transpose();
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+        Eigen::Vector3d normal = solver.eigenvectors().col(0);
+        if(normal.dot(plane.head<3>().cast<double>()) < 0.0)
+            normal = -normal;
+        plane << normal.cast<float>(), (float)(-normal.dot(centroid));
+    }
+    return inliers;
+}
+
+void CompactCloudFilter::euclideanClusters(const std::vector<compact_point> &points, float tolerance, int min_size, int max_size,
+                                           std::vector<std::vector<int> > &clusters)
+{
+    clusters.clear();
+    int n = points.size();
+    //Cells of tolerance size: neighbors of a point are in its 27 surrounding cells
+    int cell = (int)ceilf(tolerance*1000.0f);
+    if(cell < 1)
+        cell = 1;
+    double tolerance_mm = tolerance*1000.0;
+    double tolerance2 = tolerance_mm*tolerance_mm;
+
+    this->keyed.resize(n);
+    for(int i=0; i < n; i++)
+    {
+        const compact_point &p = points[i];
+        this->keyed[i].key = cellKey(floorDiv(p.x, cell), floorDiv(p.y, cell), floorDiv(p.z, cell));
+        this->keyed[i].index = i;
+    }
+    std::sort(this->keyed.begin(), this->keyed.end(), keyLess);
+    this->cell_keys.clear();
+    this->cell_start.clear();
+    for(int k=0; k < n; k++)
+    {
+        if((k == 0) || (this->keyed[k].key != this->keyed[k-1].key))
+        {
+            this->cell_keys.push_back(this->keyed[k].key);
+            this->cell_start.push_back(k);
+        }
+    }
+    this->cell_start.push_back(n);
+
+    this->visited.assign(n, 0);
+    for(int i=0; i < n; i++)
+    {
+        if(this->visited[i])
+            continue;
+        this->queue.clear();
+        this->queue.push_back(i);
+        this->visited[i] = 1;
+        for(int q=0; q < this->queue.size(); q++)
+        {
+            const compact_point &p = points[this->queue[q]];
+            int cx = floorDiv(p.x, cell);
+            int cy = floorDiv(p.y, cell);
+            int cz = floorDiv(p.z, cell);
+            for(int dz=-1; dz <= 1; dz++)
+            {
+                for(int dy=-1; dy <= 1; dy++)
+                {
+                    for(int dx=-1; dx <= 1; dx++)
+                    {
+                        int c = this->findCell(cellKey(cx + dx, cy + dy, cz + dz));
+                        if(c < 0)
+                            continue;
+                        for(int k=this->cell_start[c]; k < this->cell_start[c+1]; k++)
+                        {
+                            int j = this->keyed[k].index;
+                            if(this->visited[j])
+                                continue;
+                            double ddx = points[j].x - p.x;
+                            double ddy = points[j].y - p.y;
+                            double ddz = points[j].z - p.z;
+                            if(ddx*ddx + ddy*ddy + ddz*ddz <= tolerance2)
+                            {
+                                this->visited[j] = 1;
+                                this->queue.push_back(j);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if((this->queue.size() >= min_size) && (this->queue.size() <= max_size))
+        {
+            clusters.push_back(this->queue);
+            std::sort(clusters.back().begin(), clusters.back().end());
+        }
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), clusterLarger);
+}
+
+
+//Private Function---------------------------------------------------------
+
+int CompactCloudFilter::floorDiv(int a, int b)
+{
+    return (a >= 0) ? a/b : -((-a + b - 1)/b);
+}
+
+int64_t CompactCloudFilter::cellKey(int cx, int cy, int cz)
+{
+    const int64_t offset = 1 << 20;
+    return ((cx + offset) << 42) | ((cy + offset) << 21) | (cz + offset);
+}
+
+int CompactCloudFilter::findCell(int64_t key)
+{
+    std::vector<int64_t>::iterator it = std::lower_bound(this->cell_keys.begin(), this->cell_keys.end(), key);
+    if((it == this->cell_keys.end()) || (*it != key))
+        return -1;
+    return it - this->cell_keys.begin();
+}
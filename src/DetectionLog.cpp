@@ -0,0 +1,208 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <DetectionLog.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+//---------------DetectionLogWriter---------------------
+DetectionLogWriter::DetectionLogWriter()
+{
+    this->file = NULL;
+    this->dropped_bytes = 0;
+}
+
+DetectionLogWriter::~DetectionLogWriter()
+{
+    this->close();
+}
+
+bool DetectionLogWriter::open(std::string filename)
+{
+    this->close();
+    this->dropped_bytes = 0;
+    this->file = fopen(filename.c_str(), "r+b");
+    if((this->file == NULL) && (errno == ENOENT))
+        this->file = fopen(filename.c_str(), "w+b");
+    if(this->file == NULL)
+        return false;
+    if((fseeko(this->file, 0, SEEK_END) != 0) || !this->validate(ftello(this->file)))
+    {
+        this->close();
+        return false;
+    }
+    return true;
+}
+
+void DetectionLogWriter::close(void)
+{
+    if(this->file != NULL)
+        fclose(this->file);
+    this->file = NULL;
+}
+
+bool DetectionLogWriter::isOpen(void)
+{
+    return this->file != NULL;
+}
+
+size_t DetectionLogWriter::getDroppedBytes(void)
+{
+    return this->dropped_bytes;
+}
+
+bool DetectionLogWriter::write(double stamp, const std::vector<Eigen::Vector3f> &centers, const std::vector<float> &confidences)
+{
+    if(this->file == NULL)
+        return false;
+    detection_log_frame frame;
+    frame.stamp = stamp;
+    frame.count = centers.size();
+    frame.reserved = 0;
+    this->entry_buffer.resize(centers.size());
+    for(int i=0; i < centers.size(); i++)
+    {
+        this->entry_buffer[i].x = centers[i](0);
+        this->entry_buffer[i].y = centers[i](1);
+        this->entry_buffer[i].z = centers[i](2);
+        this->entry_buffer[i].confidence = (i < confidences.size()) ? confidences[i] : 0.0f;
+    }
+    bool ok = (fwrite(&frame, sizeof(frame), 1, this->file) == 1);
+    if(ok && !centers.empty())
+        ok = (fwrite(&this->entry_buffer[0], sizeof(detection_log_entry), centers.size(), this->file) == centers.size());
+    //One record per frame, flushed so a crash loses at most the frame being written
+    fflush(this->file);
+    return ok;
+}
+
+
+//Private Function---------------------------------------------------------
+
+bool DetectionLogWriter::validate(off_t file_size)
+{
+    detection_log_header header;
+    if(file_size == 0)
+    {
+        header.magic = DETECTION_LOG_MAGIC;
+        header.version = DETECTION_LOG_VERSION;
+        return fwrite(&header, sizeof(header), 1, this->file) == 1;
+    }
+
+    //Only append to a log of this version
+    rewind(this->file);
+    if(fread(&header, sizeof(header), 1, this->file) != 1)
+        return false;
+    if((header.magic != DETECTION_LOG_MAGIC) || (header.version != DETECTION_LOG_VERSION))
+        return false;
+
+    //Walk the frames as DetectionLogReader does: a frame cut by a crash is dropped, appended frames start after the last
+    //complete one
+    off_t offset = sizeof(detection_log_header);
+    detection_log_frame frame;
+    while(offset + (off_t)sizeof(detection_log_frame) <= file_size)
+    {
+        if((fseeko(this->file, offset, SEEK_SET) != 0) || (fread(&frame, sizeof(frame), 1, this->file) != 1))
+            return false;
+        off_t frame_size = sizeof(detection_log_frame) + (off_t)frame.count*sizeof(detection_log_entry);
+        if(offset + frame_size > file_size)
+            break;
+        offset += frame_size;
+    }
+    if(offset < file_size)
+    {
+        fflush(this->file);
+        if(ftruncate(fileno(this->file), offset) != 0)
+            return false;
+        this->dropped_bytes = file_size - offset;
+    }
+    return fseeko(this->file, 0, SEEK_END) == 0;
+}
+
+
+//---------------DetectionLogReader---------------------
+DetectionLogReader::DetectionLogReader()
+{
+    this->data = NULL;
+    this->data_size = 0;
+}
+
+DetectionLogReader::~DetectionLogReader()
+{
+    this->close();
+}
+
+bool DetectionLogReader::open(std::string filename)
+{
+    this->close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if((fstat(fd, &st) != 0) || (st.st_size < (off_t)sizeof(detection_log_header)))
+    {
+        ::close(fd);
+        return false;
+    }
+    void *mapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(mapped == MAP_FAILED)
+        return false;
+    this->data = (const char*)mapped;
+    this->data_size = st.st_size;
+
+    const detection_log_header *header = (const detection_log_header*)this->data;
+    if((header->magic != DETECTION_LOG_MAGIC) || (header->version != DETECTION_LOG_VERSION))
+    {
+        this->close();
+        return false;
+    }
+
+    size_t offset = sizeof(detection_log_header);
+    while(offset + sizeof(detection_log_frame) <= this->data_size)
+    {
+        const detection_log_frame *frame = (const detection_log_frame*)(this->data + offset);
+        size_t frame_size = sizeof(detection_log_frame) + frame->count*sizeof(detection_log_entry);
+        if(offset + frame_size > this->data_size)
+            break;
+        this->frame_offset.push_back(offset);
+        offset += frame_size;
+    }
+    return true;
+}
+
+void DetectionLogReader::close(void)
+{
+    if(this->data != NULL)
+        munmap((void*)this->data, this->data_size);
+    this->data = NULL;
+    this->data_size = 0;
+    this->frame_offset.clear();
+}
+
+int DetectionLogReader::size(void) const
+{
+    return this->frame_offset.size();
+}
+
+double DetectionLogReader::getStamp(int frame) const
+{
+    return ((const detection_log_frame*)(this->data + this->frame_offset[frame]))->stamp;
+}
+
+void DetectionLogReader::getFrame(int frame, std::vector<Eigen::Vector3f> &centers, std::vector<float> &confidences) const
+{
+    const detection_log_frame *header = (const detection_log_frame*)(this->data + this->frame_offset[frame]);
+    const detection_log_entry *entry = (const detection_log_entry*)(header + 1);
+    centers.resize(header->count);
+    confidences.resize(header->count);
+    for(int i=0; i < header->count; i++)
+    {
+        centers[i] << entry[i].x, entry[i].y, entry[i].z;
+        confidences[i] = entry[i].confidence;
+    }
+}
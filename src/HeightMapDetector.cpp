@@ -0,0 +1,343 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <HeightMapDetector.h>
+#include <algorithm>
+
+
+//3x3 passes as plain loops over contiguous rows (no branch per element): vectorized by the compiler
+static void maxRow3(const float *in, float *out, int n)
+{
+    for(int c=0; c < n; c++)
+        out[c] = in[c];
+    for(int c=1; c < n; c++)
+        out[c] = std::max(out[c], in[c-1]);
+    for(int c=0; c < n-1; c++)
+        out[c] = std::max(out[c], in[c+1]);
+}
+
+static void maxColumn3(const float *up, const float *mid, const float *down, float *out, int n)
+{
+    for(int c=0; c < n; c++)
+        out[c] = std::max(std::max(up[c], mid[c]), down[c]);
+}
+
+static void sumRow3(const int *in, int *out, int n)
+{
+    for(int c=0; c < n; c++)
+        out[c] = in[c];
+    for(int c=1; c < n; c++)
+        out[c] += in[c-1];
+    for(int c=0; c < n-1; c++)
+        out[c] += in[c+1];
+}
+
+
+//Public Function
+HeightMapDetector::HeightMapDetector()
+{
+    this->cell_size = DEFAULT_HEIGHT_MAP_CELL_SIZE;
+    this->min_density = DEFAULT_HEIGHT_MAP_MIN_DENSITY;
+    this->person_radius = DEFAULT_HEIGHT_MAP_PERSON_RADIUS;
+    this->width = 0;
+    this->height = 0;
+    this->origin = Eigen::Vector2f::Zero();
+}
+
+void HeightMapDetector::setCellSize(float size)
+{
+    if(size > 0.0f)
+        this->cell_size = size;
+}
+
+void HeightMapDetector::setMinDensity(int points)
+{
+    this->min_density = points;
+}
+
+void HeightMapDetector::setPersonRadius(float radius)
+{
+    if(radius > 0.0f)
+        this->person_radius = radius;
+}
+
+void HeightMapDetector::detect(const std::vector<compact_point> &points, const Eigen::Vector4f &ground, float min_height,
+                               float max_height, float head_min_distance, int min_points, std::vector<std::vector<int> > &candidates)
+{
+    candidates.clear();
+    this->heads.clear();
+    this->width = 0;
+    this->height = 0;
+    Eigen::Vector3f normal = ground.head<3>();
+    float norm = normal.norm();
+    if(norm <= 0.0f)
+        return;
+    normal /= norm;
+    float offset = ground(3)/norm;
+    //Ground plane basis: camera x projected on the plane, then normal x u (forward for a level camera)
+    Eigen::Vector3f axis_u = Eigen::Vector3f::UnitX() - normal*normal(0);
+    if(axis_u.norm() < 1e-3f)
+        axis_u = Eigen::Vector3f::UnitZ() - normal*normal(2);
+    axis_u.normalize();
+    Eigen::Vector3f axis_v = normal.cross(axis_u);
+
+    //Project the points between the ground and max_height
+    float inverse_cell = 1.0f/this->cell_size;
+    int n = points.size();
+    this->point_cell.assign(n, -1);
+    this->point_position.resize(n);
+    this->point_height.resize(n);
+    int min_col = 0, max_col = -1, min_row = 0, max_row = -1;
+    bool empty = true;
+    for(int i=0; i < n; i++)
+    {
+        const compact_point &cp = points[i];
+        Eigen::Vector3f p(CompactCloud::toMeter(cp.x), CompactCloud::toMeter(cp.y), CompactCloud::toMeter(cp.z));
+        float h = normal.dot(p) + offset;
+        if(!((h > 0.0f) && (h <= max_height)))
+            continue;
+        Eigen::Vector2f position(axis_u.dot(p), axis_v.dot(p));
+        int col = (int)floorf(position(0)*inverse_cell);
+        int row = (int)floorf(position(1)*inverse_cell);
+        if(empty)
+        {
+            min_col = max_col = col;
+            min_row = max_row = row;
+            empty = false;
+        }
+        min_col = std::min(min_col, col);
+        max_col = std::max(max_col, col);
+        min_row = std::min(min_row, row);
+        max_row = std::max(max_row, row);
+        this->point_position[i] = position;
+        this->point_height[i] = h;
+        this->point_cell[i] = 0;
+    }
+    if(empty)
+        return;
+    if((int64_t)(max_col - min_col + 1)*(max_row - min_row + 1) > HEIGHT_MAP_MAX_CELLS)
+        return;
+    this->width = max_col - min_col + 1;
+    this->height = max_row - min_row + 1;
+    this->origin << min_col*this->cell_size, min_row*this->cell_size;
+
+    //Max height and density channels
+    int cells = this->width*this->height;
+    this->max_height.assign(cells, 0.0f);
+    this->density.assign(cells, 0);
+    for(int i=0; i < n; i++)
+    {
+        if(this->point_cell[i] < 0)
+            continue;
+        int col = (int)floorf(this->point_position[i](0)*inverse_cell) - min_col;
+        int row = (int)floorf(this->point_position[i](1)*inverse_cell) - min_row;
+        int cell = row*this->width + col;
+        this->point_cell[i] = cell;
+        this->max_height[cell] = std::max(this->max_height[cell], this->point_height[i]);
+        this->density[cell]++;
+    }
+
+    this->findHeads(min_height, head_min_distance);
+    if(this->heads.empty())
+        return;
+    this->labelComponents();
+    this->assignCells();
+
+    //Points of each head, too small candidates dropped
+    candidates.resize(this->heads.size());
+    for(int i=0; i < n; i++)
+    {
+        if(this->point_cell[i] < 0)
+            continue;
+        int head = this->cell_head[this->point_cell[i]];
+        if(head >= 0)
+            candidates[head].push_back(i);
+    }
+    int kept = 0;
+    for(int k=0; k < candidates.size(); k++)
+    {
+        if(candidates[k].size() < min_points)
+            continue;
+        if(kept != k)
+            candidates[kept].swap(candidates[k]);
+        kept++;
+    }
+    candidates.resize(kept);
+}
+
+int HeightMapDetector::getWidth(void)
+{
+    return this->width;
+}
+
+int HeightMapDetector::getHeight(void)
+{
+    return this->height;
+}
+
+const std::vector<float>& HeightMapDetector::getMaxHeightChannel(void)
+{
+    return this->max_height;
+}
+
+const std::vector<int>& HeightMapDetector::getDensityChannel(void)
+{
+    return this->density;
+}
+
+const std::vector<height_map_head>& HeightMapDetector::getHeads(void)
+{
+    return this->heads;
+}
+
+
+//Private Function---------------------------------------------------------
+
+void HeightMapDetector::findHeads(float min_height, float head_min_distance)
+{
+    //3x3 max of the height and 3x3 sum of the density, separable: rows then columns
+    int cells = this->width*this->height;
+    this->row_buffer.resize(cells);
+    this->dilated.resize(cells);
+    this->row_sum.resize(cells);
+    this->box_density.resize(cells);
+    for(int r=0; r < this->height; r++)
+    {
+        maxRow3(&this->max_height[r*this->width], &this->row_buffer[r*this->width], this->width);
+        sumRow3(&this->density[r*this->width], &this->row_sum[r*this->width], this->width);
+    }
+    for(int r=0; r < this->height; r++)
+    {
+        int up = (r > 0) ? r - 1 : r;
+        int down = (r < this->height - 1) ? r + 1 : r;
+        maxColumn3(&this->row_buffer[up*this->width], &this->row_buffer[r*this->width], &this->row_buffer[down*this->width],
+                   &this->dilated[r*this->width], this->width);
+        int *out = &this->box_density[r*this->width];
+        const int *mid = &this->row_sum[r*this->width];
+        for(int c=0; c < this->width; c++)
+            out[c] = mid[c];
+        if(up != r)
+        {
+            const int *in = &this->row_sum[up*this->width];
+            for(int c=0; c < this->width; c++)
+                out[c] += in[c];
+        }
+        if(down != r)
+        {
+            const int *in = &this->row_sum[down*this->width];
+            for(int c=0; c < this->width; c++)
+                out[c] += in[c];
+        }
+    }
+
+    //Local maxima within the height limits, dense enough not to be a stray point
+    this->maxima.clear();
+    for(int cell=0; cell < cells; cell++)
+    {
+        float h = this->max_height[cell];
+        if((this->density[cell] == 0) || (h < min_height) || (h < this->dilated[cell]) || (this->box_density[cell] < this->min_density))
+            continue;
+        height_map_head head;
+        head.cell = cell;
+        head.height = h;
+        head.position = this->origin + Eigen::Vector2f((cell % this->width) + 0.5f, (cell / this->width) + 0.5f)*this->cell_size;
+        head.component = -1;
+        this->maxima.push_back(head);
+    }
+
+    //Highest first, heads closer than head_min_distance to a kept one are the same person (flat tops give several maxima)
+    std::sort(this->maxima.begin(), this->maxima.end(), headHigher);
+    float min_distance2 = head_min_distance*head_min_distance;
+    for(int k=0; k < this->maxima.size(); k++)
+    {
+        bool near = false;
+        for(int j=0; j < this->heads.size(); j++)
+        {
+            if((this->maxima[k].position - this->heads[j].position).squaredNorm() < min_distance2)
+            {
+                near = true;
+                break;
+            }
+        }
+        if(!near)
+            this->heads.push_back(this->maxima[k]);
+    }
+}
+
+void HeightMapDetector::labelComponents(void)
+{
+    //8-connected components of the occupied cells
+    int cells = this->width*this->height;
+    this->component.assign(cells, -1);
+    int label = 0;
+    for(int start=0; start < cells; start++)
+    {
+        if((this->density[start] == 0) || (this->component[start] >= 0))
+            continue;
+        this->queue.clear();
+        this->queue.push_back(start);
+        this->component[start] = label;
+        for(int q=0; q < this->queue.size(); q++)
+        {
+            int cell = this->queue[q];
+            int row = cell / this->width;
+            int col = cell % this->width;
+            for(int dr=-1; dr <= 1; dr++)
+            {
+                int r = row + dr;
+                if((r < 0) || (r >= this->height))
+                    continue;
+                for(int dc=-1; dc <= 1; dc++)
+                {
+                    int c = col + dc;
+                    if((c < 0) || (c >= this->width))
+                        continue;
+                    int next = r*this->width + c;
+                    if((this->density[next] > 0) && (this->component[next] < 0))
+                    {
+                        this->component[next] = label;
+                        this->queue.push_back(next);
+                    }
+                }
+            }
+        }
+        label++;
+    }
+    for(int k=0; k < this->heads.size(); k++)
+        this->heads[k].component = this->component[this->heads[k].cell];
+}
+
+void HeightMapDetector::assignCells(void)
+{
+    //Each cell of a component to its nearest head of the same component, within the person radius
+    int cells = this->width*this->height;
+    this->cell_head.assign(cells, -1);
+    this->cell_distance.assign(cells, 0.0f);
+    int window = (int)ceilf(this->person_radius/this->cell_size);
+    float radius2 = this->person_radius*this->person_radius;
+    for(int k=0; k < this->heads.size(); k++)
+    {
+        const height_map_head &head = this->heads[k];
+        int row = head.cell / this->width;
+        int col = head.cell % this->width;
+        for(int r=std::max(0, row - window); r <= std::min(this->height - 1, row + window); r++)
+        {
+            for(int c=std::max(0, col - window); c <= std::min(this->width - 1, col + window); c++)
+            {
+                int cell = r*this->width + c;
+                if(this->component[cell] != head.component)
+                    continue;
+                Eigen::Vector2f center = this->origin + Eigen::Vector2f(c + 0.5f, r + 0.5f)*this->cell_size;
+                float distance2 = (center - head.position).squaredNorm();
+                if(distance2 > radius2)
+                    continue;
+                if((this->cell_head[cell] < 0) || (distance2 < this->cell_distance[cell]))
+                {
+                    this->cell_head[cell] = k;
+                    this->cell_distance[cell] = distance2;
+                }
+            }
+        }
+    }
+}
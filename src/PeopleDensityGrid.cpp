@@ -0,0 +1,223 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <PeopleDensityGrid.h>
+#include <algorithm>
+#include <cmath>
+
+
+//Public Function
+PeopleDensityGrid::PeopleDensityGrid()
+{
+    this->decay_time = DEFAULT_DENSITY_GRID_DECAY_TIME;
+    Eigen::Vector2f origin(-0.5f*DEFAULT_DENSITY_GRID_WIDTH*DEFAULT_DENSITY_GRID_RESOLUTION,
+                           -0.5f*DEFAULT_DENSITY_GRID_HEIGHT*DEFAULT_DENSITY_GRID_RESOLUTION);
+    this->setGeometry(DEFAULT_DENSITY_GRID_RESOLUTION, DEFAULT_DENSITY_GRID_WIDTH, DEFAULT_DENSITY_GRID_HEIGHT, origin);
+}
+
+void PeopleDensityGrid::setGeometry(float resolution, int width, int height, const Eigen::Vector2f &origin)
+{
+    boost::mutex::scoped_lock lock(this->grid_mutex);
+    this->resolution = (resolution > 0.0f) ? resolution : (float)DEFAULT_DENSITY_GRID_RESOLUTION;
+    this->width = (width > 0) ? width : 1;
+    this->height = (height > 0) ? height : 1;
+    this->origin = origin;
+    density_cell empty = {0.0f, 0.0, 0};
+    this->cells.assign(this->width*this->height, empty);
+    this->is_active.assign(this->width*this->height, 0);
+    this->active.clear();
+    this->track_cell.clear();
+}
+
+void PeopleDensityGrid::setDecayTime(float decay_time)
+{
+    {
+        boost::mutex::scoped_lock lock(this->grid_mutex);
+        this->decay_time = decay_time;
+    }
+    this->clear();
+}
+
+void PeopleDensityGrid::update(const std::vector<int> &ids, const std::vector<Eigen::Vector2f> &positions, double stamp)
+{
+    boost::mutex::scoped_lock lock(this->grid_mutex);
+    this->current_cell.clear();
+    for(int i=0; i < ids.size(); i++)
+    {
+        int cell = this->cellAt(positions[i]);
+        this->current_cell[ids[i]] = cell;
+        std::map<int, int>::iterator last = this->track_cell.find(ids[i]);
+        if(last == this->track_cell.end())
+        {
+            //Created
+            this->addOccupancy(cell, 1, stamp);
+        }
+        else if(last->second != cell)
+        {
+            //Moved to another cell
+            this->addOccupancy(last->second, -1, stamp);
+            this->addOccupancy(cell, 1, stamp);
+        }
+    }
+    for(std::map<int, int>::iterator it = this->track_cell.begin(); it != this->track_cell.end(); ++it)
+    {
+        //Removed
+        if(this->current_cell.find(it->first) == this->current_cell.end())
+            this->addOccupancy(it->second, -1, stamp);
+    }
+    this->track_cell.swap(this->current_cell);
+}
+
+void PeopleDensityGrid::removeAllTracks(double stamp)
+{
+    boost::mutex::scoped_lock lock(this->grid_mutex);
+    for(std::map<int, int>::iterator it = this->track_cell.begin(); it != this->track_cell.end(); ++it)
+        this->addOccupancy(it->second, -1, stamp);
+    this->track_cell.clear();
+}
+
+void PeopleDensityGrid::clear(void)
+{
+    boost::mutex::scoped_lock lock(this->grid_mutex);
+    density_cell empty = {0.0f, 0.0, 0};
+    for(int k=0; k < this->active.size(); k++)
+    {
+        this->cells[this->active[k]] = empty;
+        this->is_active[this->active[k]] = 0;
+    }
+    this->active.clear();
+    this->track_cell.clear();
+}
+
+bool PeopleDensityGrid::getDensity(const Eigen::Vector2f &center, float radius, double stamp, float &density, int &occupancy)
+{
+    boost::mutex::scoped_lock lock(this->grid_mutex);
+    density = 0.0f;
+    occupancy = 0;
+    int cell = this->cellAt(center);
+    if(cell < 0)
+        return false;
+    if(radius <= 0.0f)
+    {
+        density = this->decayedDensity(this->cells[cell], stamp);
+        occupancy = this->cells[cell].occupancy;
+        return true;
+    }
+
+    int row = cell / this->width;
+    int col = cell % this->width;
+    int window = (int)ceilf(radius/this->resolution);
+    float radius2 = radius*radius;
+    for(int r=std::max(0, row - window); r <= std::min(this->height - 1, row + window); r++)
+    {
+        for(int c=std::max(0, col - window); c <= std::min(this->width - 1, col + window); c++)
+        {
+            Eigen::Vector2f cell_center = this->origin + Eigen::Vector2f(c + 0.5f, r + 0.5f)*this->resolution;
+            if((cell_center - center).squaredNorm() > radius2)
+                continue;
+            const density_cell &cell_data = this->cells[r*this->width + c];
+            density += this->decayedDensity(cell_data, stamp);
+            occupancy += cell_data.occupancy;
+        }
+    }
+    return true;
+}
+
+void PeopleDensityGrid::getActiveCells(double stamp, std::vector<int> &cells, std::vector<float> &density, std::vector<int> &occupancy)
+{
+    boost::mutex::scoped_lock lock(this->grid_mutex);
+    cells.clear();
+    density.clear();
+    occupancy.clear();
+    density_cell empty = {0.0f, 0.0, 0};
+    int kept = 0;
+    for(int k=0; k < this->active.size(); k++)
+    {
+        int cell = this->active[k];
+        float d = this->decayedDensity(this->cells[cell], stamp);
+        if((this->cells[cell].occupancy == 0) && (d < DENSITY_GRID_MIN_DENSITY))
+        {
+            this->cells[cell] = empty;
+            this->is_active[cell] = 0;
+            continue;
+        }
+        this->active[kept++] = cell;
+    }
+    this->active.resize(kept);
+
+    //Row major output
+    std::sort(this->active.begin(), this->active.end());
+    for(int k=0; k < this->active.size(); k++)
+    {
+        int cell = this->active[k];
+        cells.push_back(cell);
+        density.push_back(this->decayedDensity(this->cells[cell], stamp));
+        occupancy.push_back(this->cells[cell].occupancy);
+    }
+}
+
+float PeopleDensityGrid::getResolution(void)
+{
+    return this->resolution;
+}
+
+int PeopleDensityGrid::getWidth(void)
+{
+    return this->width;
+}
+
+int PeopleDensityGrid::getHeight(void)
+{
+    return this->height;
+}
+
+Eigen::Vector2f PeopleDensityGrid::getOrigin(void)
+{
+    return this->origin;
+}
+
+float PeopleDensityGrid::getDecayTime(void)
+{
+    return this->decay_time;
+}
+
+
+//Private Function---------------------------------------------------------
+
+int PeopleDensityGrid::cellAt(const Eigen::Vector2f &position)
+{
+    float col = floorf((position(0) - this->origin(0))/this->resolution);
+    float row = floorf((position(1) - this->origin(1))/this->resolution);
+    if(!((col >= 0.0f) && (col < this->width) && (row >= 0.0f) && (row < this->height)))
+        return -1;
+    return (int)row*this->width + (int)col;
+}
+
+float PeopleDensityGrid::decayedDensity(const density_cell &cell, double stamp)
+{
+    //dD/dt = occupancy - D/decay_time: D tends to occupancy*decay_time
+    double dt = stamp - cell.stamp;
+    if(dt <= 0.0)
+        return cell.density;
+    if(this->decay_time <= 0.0f)
+        return (float)(cell.density + cell.occupancy*dt);
+    double steady = cell.occupancy*(double)this->decay_time;
+    return (float)(steady + (cell.density - steady)*exp(-dt/this->decay_time));
+}
+
+void PeopleDensityGrid::addOccupancy(int cell, int delta, double stamp)
+{
+    if(cell < 0)
+        return;
+    density_cell &c = this->cells[cell];
+    c.density = this->decayedDensity(c, stamp);
+    if(stamp > c.stamp)
+        c.stamp = stamp;
+    c.occupancy = std::max(0, c.occupancy + delta);
+    if(!this->is_active[cell])
+    {
+        this->is_active[cell] = 1;
+        this->active.push_back(cell);
+    }
+}
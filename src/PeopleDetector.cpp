@@ -8,24 +8,36 @@ using namespace Eigen;
 
 //---------------Public---------------------
 
-PeopleDetector::PeopleDetector()
+PeopleDetector::PeopleDetector():
+        no_ground_cloud(new PointCloudT)
 {
     //empty constructor for easily coding purpose
+    this->downsample_threads = 0;
+    this->height_map_candidates = false;
+    this->ground_coeffs_available = false;
 }
 
 void PeopleDetector::initPeopleDetector(std::string svm_filename,Eigen::Matrix3f rgb_intrinsics_matrix, double minheight, double maxheight,
-                                         double min_condf, double headmindist, double detectrange)
+                                         double min_condf, double headmindist, double detectrange, double voxelsize,
+                                         std::string svm_cache_filename)
+{
+    this->loadClassifier(svm_filename, svm_cache_filename);   // load trained SVM
+    this->rgb_intrinsics_matrix = rgb_intrinsics_matrix;                       // kept for the compact pipeline classifier
+    this->people_detector.setIntrinsics(rgb_intrinsics_matrix);            // set RGB camera intrinsic parameters
+    this->people_detector.setClassifier(this->person_classifier);                // set person classifier
+    this->setDetectorParameters(minheight, maxheight, min_condf, headmindist, detectrange, voxelsize);
+}
+
+void PeopleDetector::setDetectorParameters(double minheight, double maxheight, double min_condf, double headmindist,
+                                           double detectrange, double voxelsize)
 {
-    float voxel_size = 0.06;
     this->heads_minimum_distance = headmindist;
     this->min_height = minheight;
     this->max_height = maxheight;
     this->detect_range = detectrange;
     this->min_confidence = min_condf;
-    this->person_classifier.loadSVMFromFile(svm_filename);   // load trained SVM
-    this->people_detector.setVoxelSize(voxel_size);                        // set the voxel size
-    this->people_detector.setIntrinsics(rgb_intrinsics_matrix);            // set RGB camera intrinsic parameters
-    this->people_detector.setClassifier(this->person_classifier);                // set person classifier
+    this->voxel_size = voxelsize;
+    this->people_detector.setVoxelSize((float)voxel_size);                        // set the voxel size (before height limits: min/max cluster points depend on it)
     this->people_detector.setHeightLimits((float)min_height, (float)max_height);         // for pcl 1.7.1
     this->people_detector.setMinimumDistanceBetweenHeads((float)heads_minimum_distance);
 }
@@ -36,40 +48,102 @@ void PeopleDetector::setRobotFrame(std::string camera_link,std::string robot_bas
     this->robot_frame = robot_base_link;
 }
 
+void PeopleDetector::initTransformListener(void)
+{
+    //Not in the constructor: tools giving ground coefficients run without a ROS master
+    if(!this->listener)
+        this->listener.reset(new tf::TransformListener());
+}
+
 
 
-void PeopleDetector::getPeopleCenter(PointCloudT::Ptr cloud, std::vector<Eigen::Vector3f>& center_list){
+bool PeopleDetector::getPeopleCenter(PointCloudT::Ptr cloud, std::vector<Eigen::Vector3f>& center_list)
+{
+    std::vector<float> confidence_list;
+    return this->getPeopleCenter(cloud, center_list, confidence_list);
+}
+
+bool PeopleDetector::getPeopleCenter(PointCloudT::Ptr cloud, std::vector<Eigen::Vector3f>& center_list,
+                                     std::vector<float>& confidence_list)
+{
 
     if(this->camera_optical_frame.empty())
     {
         ROS_WARN("CAMERA FRAME HAS NOT BEEN SET : ABORT CALCULATION");
-        return;
+        return false;
     }
     else if(this->robot_frame.empty())
     {
         ROS_WARN("ROBOT FRAME HAS NOT BEEN SET : ABORT CALCULATION");
-        return;
+        return false;
     }
 
-    Eigen::VectorXf ground_coeffs = getGroundCoeffs();
+    ros::Time stamp;
+    pcl_conversions::fromPCL(cloud->header.stamp, stamp);
+    Eigen::VectorXf ground_coeffs;
+    if(!this->getGroundCoeffs(stamp, ground_coeffs))
+        return false;
+    this->getPeopleCenter(cloud, ground_coeffs, center_list, confidence_list);
+    return true;
+}
+
+void PeopleDetector::getPeopleCenter(PointCloudT::Ptr cloud, Eigen::VectorXf ground_coeffs, std::vector<Eigen::Vector3f>& center_list,
+                                     std::vector<float>& confidence_list)
+{
     //std::cout << "Ground plane: " << ground_coeffs(0) << " " << ground_coeffs(1) << " " << ground_coeffs(2) << " " << ground_coeffs(3) << std::endl;
     // Perform people detection on the new cloud:
     this->clusters.clear();
     this->people_detector.setInputCloud(cloud);
     this->people_detector.setGround(ground_coeffs);                    // set floor coefficients
     this->people_detector.compute(clusters);                           // perform people detection
-    unsigned int k = 0;
-    for(std::vector< pcl::people::PersonCluster<PointT> >::iterator it = this->clusters.begin(); it != this->clusters.end(); ++it)
+    this->selectPeopleCenters(center_list, confidence_list);
+}
+
+bool PeopleDetector::getPeopleCenter(const CompactCloud &cloud, std::vector<Eigen::Vector3f>& center_list,
+                                     std::vector<float>& confidence_list)
+{
+    if(this->camera_optical_frame.empty())
     {
-        if(it->getPersonConfidence() > this->min_confidence) // draw only people with confidence above a threshold
-        {
-            k++;
-            Eigen::Vector3f temp = it->getTCenter();
-            if(temp(2) < this->detect_range)
-                center_list.push_back(temp);
-            std::cout << "Person " << k << " Position : X = " << temp(0) << " ,Y = " << temp(1) << " ,Z = " << temp(2) << std::endl;
-        }
+        ROS_WARN("CAMERA FRAME HAS NOT BEEN SET : ABORT CALCULATION");
+        return false;
+    }
+    else if(this->robot_frame.empty())
+    {
+        ROS_WARN("ROBOT FRAME HAS NOT BEEN SET : ABORT CALCULATION");
+        return false;
     }
+
+    ros::Time stamp;
+    pcl_conversions::fromPCL(cloud.stamp, stamp);
+    Eigen::VectorXf ground_coeffs;
+    if(!this->getGroundCoeffs(stamp, ground_coeffs))
+        return false;
+    this->getPeopleCenter(cloud, ground_coeffs, center_list, confidence_list);
+    return true;
+}
+
+void PeopleDetector::getPeopleCenter(const CompactCloud &cloud, Eigen::VectorXf ground_coeffs, std::vector<Eigen::Vector3f>& center_list,
+                                     std::vector<float>& confidence_list)
+{
+    this->computeCompact(cloud, ground_coeffs);
+    this->selectPeopleCenters(center_list, confidence_list);
+}
+
+float PeopleDetector::getCropRange(void)
+{
+    return (float)(this->detect_range + DEFAULT_CROP_MARGIN);
+}
+
+void PeopleDetector::setDownsampleThreads(int threads)
+{
+    this->downsample_threads = threads;
+    this->downsampler.reset();
+}
+
+void PeopleDetector::setHeightMapCandidates(bool enable, float cell_size)
+{
+    this->height_map_candidates = enable;
+    this->height_map.setCellSize(cell_size);
 }
 
 void PeopleDetector::addNewCloudToViewer(PointCloudT::Ptr cloud, pcl::visualization::PCLVisualizer::Ptr viewer_obj)
@@ -124,14 +198,152 @@ void PeopleDetector::drawPeopleDetectBox(pcl::visualization::PCLVisualizer::Ptr
 
 
 //---------------Private-------------------
-Eigen::VectorXf PeopleDetector::getGroundCoeffs()
+void PeopleDetector::loadClassifier(std::string svm_filename, std::string svm_cache_filename)
 {
+    //Binary cache first, YAML model as fallback (and refresh the cache from it)
+    ros::WallTime start = ros::WallTime::now();
+    if(!svm_cache_filename.empty())
+    {
+        int status = SVMModelCache::load(svm_cache_filename, this->person_classifier, svm_filename);
+        if(status == SVM_MODEL_CACHE_OK)
+        {
+            ROS_INFO("Loaded SVM cache %s in %.3lf s", svm_cache_filename.c_str(), (ros::WallTime::now() - start).toSec());
+            return;
+        }
+        if(status == SVM_MODEL_CACHE_STALE)
+            ROS_WARN("SVM cache %s was not converted from %s: Loading the YAML model", svm_cache_filename.c_str(), svm_filename.c_str());
+        else if(status == SVM_MODEL_CACHE_INVALID)
+            ROS_WARN("SVM cache %s is not a valid cache: Loading the YAML model", svm_cache_filename.c_str());
+    }
+    this->person_classifier.loadSVMFromFile(svm_filename);
+    ROS_INFO("Loaded SVM model %s in %.3lf s", svm_filename.c_str(), (ros::WallTime::now() - start).toSec());
+    if(!svm_cache_filename.empty())
+    {
+        if(SVMModelCache::save(svm_cache_filename, this->person_classifier, svm_filename))
+            ROS_INFO("Wrote SVM cache %s", svm_cache_filename.c_str());
+        else
+            ROS_WARN("Cannot write SVM cache %s: use svm_model_converter", svm_cache_filename.c_str());
+    }
+}
+
+void PeopleDetector::computeCompact(const CompactCloud &cloud, Eigen::VectorXf ground_coeffs)
+{
+    //Same stages as GroundBasedPeopleDetectionApp::compute (pcl 1.7.1). Voxel grid, ground removal and clustering run on
+    //the compact points, only the small no-ground cloud is expanded for head subclustering and the classifier
+    this->clusters.clear();
+    float voxel = (float)this->voxel_size;
+    if(!this->downsampler)
+        this->downsampler.reset(new VoxelDownsampler(this->downsample_threads));
+    this->downsampler->downsample(cloud.points, voxel, this->filtered_points);
+
+    //Ground removal and update
+    Eigen::Vector4f ground(ground_coeffs(0), ground_coeffs(1), ground_coeffs(2), ground_coeffs(3));
+    int min_refit = (int)(300*0.06/voxel);
+    int inliers = this->compact_filter.removePlane(this->filtered_points, ground, voxel, min_refit, this->no_ground_points);
+    if(inliers < min_refit)
+        ROS_INFO_THROTTLE(5.0, "No groundplane update: %d inliers", inliers);
+    ground_coeffs = ground;
+
+    int min_points = (int)(this->min_height*DEFAULT_MIN_PERSON_WIDTH/voxel/voxel);
+    int max_points = (int)(this->max_height*DEFAULT_MAX_PERSON_WIDTH/voxel/voxel);
+    if(this->height_map_candidates)
+    {
+        //Height map candidates: one cluster per head, already split
+        this->height_map.detect(this->no_ground_points, ground, (float)this->min_height, (float)this->max_height,
+                                (float)this->heads_minimum_distance, min_points, this->compact_clusters);
+        CompactCloud::toPCL(this->no_ground_points, *this->no_ground_cloud);
+        float sqrt_ground_coeffs = (ground - Eigen::Vector4f(0.0f, 0.0f, 0.0f, ground(3))).norm();
+        pcl::PointIndices indices;
+        for(int i=0; i < this->compact_clusters.size(); i++)
+        {
+            indices.indices = this->compact_clusters[i];
+            this->clusters.push_back(pcl::people::PersonCluster<PointT>(this->no_ground_cloud, indices, ground_coeffs,
+                                                                          sqrt_ground_coeffs, true, false));
+        }
+    }
+    else
+    {
+        //Euclidean clustering
+        this->compact_filter.euclideanClusters(this->no_ground_points, 2*voxel, min_points, max_points, this->compact_clusters);
+        this->cluster_indices.resize(this->compact_clusters.size());
+        for(int i=0; i < this->compact_clusters.size(); i++)
+            this->cluster_indices[i].indices = this->compact_clusters[i];
+        CompactCloud::toPCL(this->no_ground_points, *this->no_ground_cloud);
+
+        //Head based sub-clustering
+        pcl::people::HeadBasedSubclustering<PointT> subclustering;
+        subclustering.setInputCloud(this->no_ground_cloud);
+        subclustering.setGround(ground_coeffs);
+        subclustering.setInitialClusters(this->cluster_indices);
+        subclustering.setHeightLimits((float)this->min_height, (float)this->max_height);
+        subclustering.setDimensionLimits(min_points, max_points);
+        subclustering.setMinimumDistanceBetweenHeads((float)this->heads_minimum_distance);
+        subclustering.setSensorPortraitOrientation(false);
+        subclustering.subcluster(this->clusters);
+    }
+
+    //Person confidence evaluation with HOG+SVM
+    pcl::PointCloud<pcl::RGB>::Ptr image = cloud.image;
+    for(std::vector< pcl::people::PersonCluster<PointT> >::iterator it = this->clusters.begin(); it != this->clusters.end(); ++it)
+    {
+        Eigen::Vector3f centroid = this->rgb_intrinsics_matrix * (it->getTCenter());
+        centroid /= centroid(2);
+        Eigen::Vector3f top = this->rgb_intrinsics_matrix * (it->getTTop());
+        top /= top(2);
+        Eigen::Vector3f bottom = this->rgb_intrinsics_matrix * (it->getTBottom());
+        bottom /= bottom(2);
+        it->setPersonConfidence(this->person_classifier.evaluate(image, bottom, top, centroid, false));
+    }
+}
+
+void PeopleDetector::selectPeopleCenters(std::vector<Eigen::Vector3f>& center_list, std::vector<float>& confidence_list)
+{
+    unsigned int k = 0;
+    for(std::vector< pcl::people::PersonCluster<PointT> >::iterator it = this->clusters.begin(); it != this->clusters.end(); ++it)
+    {
+        if(it->getPersonConfidence() > this->min_confidence) // draw only people with confidence above a threshold
+        {
+            k++;
+            Eigen::Vector3f temp = it->getTCenter();
+            if(temp(2) < this->detect_range)
+            {
+                center_list.push_back(temp);
+                confidence_list.push_back(it->getPersonConfidence());
+            }
+            std::cout << "Person " << k << " Position : X = " << temp(0) << " ,Y = " << temp(1) << " ,Z = " << temp(2) << std::endl;
+        }
+    }
+}
+
+bool PeopleDetector::getGroundCoeffs(ros::Time stamp, Eigen::VectorXf &ground_coeffs)
+{
+    //Ground plane at cloud acquisition time, latest tf if it is not available
     tf::StampedTransform transform;
-    try{
-        this->listener.lookupTransform(this->robot_frame, this->camera_optical_frame, ros::Time(0), transform);
+    bool found = false;
+    if(this->listener)
+    {
+        try{
+            if(stamp.isZero() || !this->listener->canTransform(this->robot_frame, this->camera_optical_frame, stamp))
+                stamp = ros::Time(0);
+            this->listener->lookupTransform(this->robot_frame, this->camera_optical_frame, stamp, transform);
+            found = true;
+        }
+        catch (tf::TransformException ex){
+            ROS_ERROR("%s",ex.what());
+        }
     }
-    catch (tf::TransformException ex){
-        ROS_ERROR("%s",ex.what());
+    if(!found)
+    {
+        //Never the unset transform: the last ground plane, or skip the frame until tf has one
+        if(!this->ground_coeffs_available)
+        {
+            ROS_WARN_THROTTLE(5.0, "No ground plane from tf (%s -> %s) yet: Skip frame", this->robot_frame.c_str(),
+                              this->camera_optical_frame.c_str());
+            return false;
+        }
+        ROS_WARN_THROTTLE(5.0, "No ground plane from tf: Keep the last one");
+        ground_coeffs = this->last_ground_coeffs;
+        return true;
     }
 
     Eigen::Matrix4f T;
@@ -143,6 +355,9 @@ Eigen::VectorXf PeopleDetector::getGroundCoeffs()
     coeffs_out = coeffs*T;
 
     Eigen::Vector4f re_co(4); re_co << coeffs_out(0,0), coeffs_out(0,1), coeffs_out(0,2), coeffs_out(0,3);
-    return re_co;
+    ground_coeffs = re_co;
+    this->last_ground_coeffs = re_co;
+    this->ground_coeffs_available = true;
+    return true;
 }
 
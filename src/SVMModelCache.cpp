@@ -0,0 +1,98 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <SVMModelCache.h>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+bool SVMModelCache::save(std::string filename, pcl::people::PersonClassifier<pcl::RGB> &classifier, std::string source_filename)
+{
+    std::vector<float> weights = classifier.getSVMWeights();
+    if(weights.empty())
+        return false;
+
+    svm_model_cache_header header;
+    header.magic = SVM_MODEL_CACHE_MAGIC;
+    header.version = SVM_MODEL_CACHE_VERSION;
+    header.window_height = classifier.getWindowHeight();
+    header.window_width = classifier.getWindowWidth();
+    header.offset = classifier.getSVMOffset();
+    header.weight_count = weights.size();
+    if(!sourceSignature(source_filename, header.source_size, header.source_hash))
+        return false;
+
+    FILE *file = fopen(filename.c_str(), "wb");
+    if(file == NULL)
+        return false;
+    bool ok = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+              (fwrite(&weights[0], sizeof(float), weights.size(), file) == weights.size());
+    ok = (fclose(file) == 0) && ok;
+    if(!ok)
+        remove(filename.c_str());
+    return ok;
+}
+
+int SVMModelCache::load(std::string filename, pcl::people::PersonClassifier<pcl::RGB> &classifier, std::string source_filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+        return SVM_MODEL_CACHE_MISSING;
+    struct stat st;
+    if((fstat(fd, &st) != 0) || (st.st_size < (off_t)sizeof(svm_model_cache_header)))
+    {
+        close(fd);
+        return SVM_MODEL_CACHE_INVALID;
+    }
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED)
+        return SVM_MODEL_CACHE_INVALID;
+
+    const svm_model_cache_header *header = (const svm_model_cache_header*)data;
+    int status = SVM_MODEL_CACHE_OK;
+    uint64_t source_size, source_hash;
+    if(!((header->magic == SVM_MODEL_CACHE_MAGIC) && (header->version == SVM_MODEL_CACHE_VERSION) &&
+         (header->weight_count > 0) &&
+         (st.st_size == (off_t)(sizeof(svm_model_cache_header) + header->weight_count*sizeof(float)))))
+        status = SVM_MODEL_CACHE_INVALID;
+    else if(sourceSignature(source_filename, source_size, source_hash) &&
+            ((source_size != header->source_size) || (source_hash != header->source_hash)))
+        status = SVM_MODEL_CACHE_STALE;
+    if(status == SVM_MODEL_CACHE_OK)
+    {
+        const float *weights = (const float*)(header + 1);
+        classifier.setSVM(header->window_height, header->window_width,
+                          std::vector<float>(weights, weights + header->weight_count), header->offset);
+    }
+    munmap(data, st.st_size);
+    return status;
+}
+
+bool SVMModelCache::sourceSignature(std::string filename, uint64_t &size, uint64_t &hash)
+{
+    //Content, not mtime: a checkout or copy of the same model keeps its cache
+    FILE *file = fopen(filename.c_str(), "rb");
+    if(file == NULL)
+        return false;
+    size = 0;
+    hash = 14695981039346656037ULL;
+    unsigned char buffer[65536];
+    size_t n;
+    while((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        for(size_t i=0; i < n; i++)
+        {
+            hash ^= buffer[i];
+            hash *= 1099511628211ULL;
+        }
+        size += n;
+    }
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
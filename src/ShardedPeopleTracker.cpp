@@ -0,0 +1,414 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <ShardedPeopleTracker.h>
+#include <boost/bind.hpp>
+
+
+//Public Function
+ShardedPeopleTracker::ShardedPeopleTracker(int threads) : next_shard(0), stopping(false)
+{
+    this->tile_size = DEFAULT_SHARD_TILE_SIZE;
+    this->axis[0] = DEFAULT_SHARD_AXIS_0;
+    this->axis[1] = DEFAULT_SHARD_AXIS_1;
+    this->person_get_in_track_condition = DEFAULT_GET_IN_TRACK_CONDITION;
+    this->get_in_track_check_frame = DEFAULT_GET_IN_TRACK_CHECK_FRAME;
+    this->person_out_of_track_condition = DEFAULT_OUT_OF_TRACK_CONDITION;
+    this->track_distance_threshold = 0.3;
+    this->single_track_reset_distance = 1.0;
+    this->velocity_smoothing = DEFAULT_VELOCITY_SMOOTHING;
+    this->frame_stamp = 0.0;
+    this->algorithm = MULTI_NEAREST_NEIGHBOR_TRACKER;
+    this->list_update_method = UPDATE_NORMAL;
+    this->shard_count = 0;
+
+    this->id_allocator.reset(new TrackIdAllocator);
+    this->single_tracker.setIdAllocator(this->id_allocator);
+    this->single_tracker.setHistoryCapacity(1, 1);
+    this->configureTracker(this->single_tracker);
+
+    if(threads <= 0)
+        threads = boost::thread::hardware_concurrency();
+    this->thread_count = (threads > 0) ? threads : 1;
+    if(this->thread_count > 1)
+    {
+        this->start_barrier.reset(new boost::barrier(this->thread_count));
+        this->done_barrier.reset(new boost::barrier(this->thread_count));
+        for(int i=1; i < this->thread_count; i++)
+            this->workers.create_thread(boost::bind(&ShardedPeopleTracker::workerLoop, this));
+    }
+}
+
+ShardedPeopleTracker::~ShardedPeopleTracker()
+{
+    if(this->thread_count > 1)
+    {
+        this->stopping = true;
+        this->start_barrier->wait();
+        this->workers.join_all();
+    }
+}
+
+void ShardedPeopleTracker::setTileSize(float size)
+{
+    if(size <= 0.0f)
+    {
+        ROS_WARN("Shard tile size must be positive: Keep %f", this->tile_size);
+        return;
+    }
+    this->tile_size = size;
+}
+
+void ShardedPeopleTracker::setTileAxes(int axis0, int axis1)
+{
+    if((axis0 < 0) || (axis0 > 2) || (axis1 < 0) || (axis1 > 2) || (axis0 == axis1))
+    {
+        ROS_WARN("Shard tile axes must be two different axes of 0,1,2: Keep %d,%d", this->axis[0], this->axis[1]);
+        return;
+    }
+    this->axis[0] = axis0;
+    this->axis[1] = axis1;
+}
+
+void ShardedPeopleTracker::setListUpdateConstraints(int getin, int getincheck, int getout)
+{
+    this->person_get_in_track_condition = getin;
+    this->get_in_track_check_frame = getincheck;
+    this->person_out_of_track_condition = getout;
+    this->configureTracker(this->single_tracker);
+    for(std::map<shard_tile, boost::shared_ptr<PeopleTracker> >::iterator it = this->tile_trackers.begin(); it != this->tile_trackers.end(); ++it)
+        this->configureTracker(*it->second);
+}
+
+void ShardedPeopleTracker::setTrackThreshold(float distTH)
+{
+    this->track_distance_threshold = distTH;
+    this->configureTracker(this->single_tracker);
+    for(std::map<shard_tile, boost::shared_ptr<PeopleTracker> >::iterator it = this->tile_trackers.begin(); it != this->tile_trackers.end(); ++it)
+        this->configureTracker(*it->second);
+}
+
+void ShardedPeopleTracker::setSingleTrackResetDistance(float distTH)
+{
+    this->single_track_reset_distance = distTH;
+    this->configureTracker(this->single_tracker);
+}
+
+void ShardedPeopleTracker::setVelocitySmoothing(float alpha)
+{
+    if(alpha <= 0.0f || alpha > 1.0f)
+    {
+        ROS_WARN("Velocity smoothing must be in (0,1]: Keep %f", this->velocity_smoothing);
+        return;
+    }
+    this->velocity_smoothing = alpha;
+    this->configureTracker(this->single_tracker);
+    for(std::map<shard_tile, boost::shared_ptr<PeopleTracker> >::iterator it = this->tile_trackers.begin(); it != this->tile_trackers.end(); ++it)
+        this->configureTracker(*it->second);
+}
+
+void ShardedPeopleTracker::setFrameStamp(double stamp)
+{
+    this->frame_stamp = stamp;
+}
+
+void ShardedPeopleTracker::setFrameConfidences(const std::vector<float> &confidences)
+{
+    this->frame_confidences = confidences;
+}
+
+void ShardedPeopleTracker::resetTrackID(void)
+{
+    this->id_allocator->reset();
+}
+
+TrackHistory& ShardedPeopleTracker::getTrackHistory(void)
+{
+    return this->track_history;
+}
+
+void ShardedPeopleTracker::setHistoryCapacity(int max_tracks, int samples_per_track)
+{
+    this->track_history.setCapacity(max_tracks, samples_per_track);
+}
+
+int ShardedPeopleTracker::getThreadCount(void)
+{
+    return this->thread_count;
+}
+
+int ShardedPeopleTracker::getShardCount(void)
+{
+    return this->shard_count;
+}
+
+void ShardedPeopleTracker::trackPeople(std::vector<person> &global_track_list, const std::vector<Eigen::Vector3f> &new_center_list,
+                                       int algorithm, int list_update_method)
+{
+    if(this->frame_confidences.size() != new_center_list.size())
+        this->frame_confidences.assign(new_center_list.size(), 0.0f);
+    if(algorithm != MULTI_NEAREST_NEIGHBOR_TRACKER)
+    {
+        this->shard_count = 0;
+        this->single_tracker.setFrameStamp(this->frame_stamp);
+        this->single_tracker.setFrameConfidences(this->frame_confidences);
+        this->single_tracker.trackPeople(global_track_list, new_center_list, algorithm, list_update_method);
+        this->recordHistory(global_track_list);
+        this->frame_confidences.clear();
+        return;
+    }
+    this->algorithm = algorithm;
+    this->list_update_method = list_update_method;
+
+    //Tracks to the tile of their last position
+    for(int k=0; k < this->shard_count; k++)
+    {
+        this->shards[k].world.clear();
+        this->shards[k].centers.clear();
+        this->shards[k].confidences.clear();
+    }
+    this->shard_count = 0;
+    this->shard_lookup.clear();
+    this->assignShards(global_track_list, new_center_list);
+    this->runShards();
+
+    //Merge in tile order: a track that walked out of its tile is re-homed by getTile on the next frame
+    global_track_list.clear();
+    for(std::map<shard_tile, int>::iterator it = this->shard_lookup.begin(); it != this->shard_lookup.end(); ++it)
+    {
+        std::vector<person> &world = this->shards[it->second].world;
+        this->assignNewIds(world);
+        global_track_list.insert(global_track_list.end(), world.begin(), world.end());
+    }
+    this->recordHistory(global_track_list);
+    this->frame_confidences.clear();
+}
+
+
+//Private Function---------------------------------------------------------
+
+shard_tile ShardedPeopleTracker::getTile(const Eigen::Vector3f &points)
+{
+    return shard_tile((int)floor(points(this->axis[0])/this->tile_size), (int)floor(points(this->axis[1])/this->tile_size));
+}
+
+bool ShardedPeopleTracker::inBoundaryBand(const Eigen::Vector3f &points, const shard_tile &tile)
+{
+    float u = points(this->axis[0]) - tile.first*this->tile_size;
+    float v = points(this->axis[1]) - tile.second*this->tile_size;
+    float band = this->track_distance_threshold;
+    return (u < band) || (this->tile_size - u < band) || (v < band) || (this->tile_size - v < band);
+}
+
+int ShardedPeopleTracker::getShard(const shard_tile &tile)
+{
+    std::map<shard_tile, int>::iterator it = this->shard_lookup.find(tile);
+    if(it != this->shard_lookup.end())
+        return it->second;
+    if(this->shard_count == this->shards.size())
+        this->shards.push_back(tracker_shard());
+    tracker_shard &shard = this->shards[this->shard_count];
+    shard.tile = tile;
+    shard.tracker = this->getTileTracker(tile);
+    this->shard_lookup[tile] = this->shard_count;
+    return this->shard_count++;
+}
+
+PeopleTracker* ShardedPeopleTracker::getTileTracker(const shard_tile &tile)
+{
+    boost::shared_ptr<PeopleTracker> &tracker = this->tile_trackers[tile];
+    if(!tracker)
+    {
+        tracker.reset(new PeopleTracker);
+        tracker->setVerbose(false);
+        //Placeholder ids, the real ones are given by the merge
+        tracker->setIdAllocator(boost::shared_ptr<TrackIdAllocator>(new TrackIdAllocator(FIRST_PLACEHOLDER_TRACK_ID)));
+        tracker->setRecordHistory(false);
+        tracker->setHistoryCapacity(1, 1);
+        this->configureTracker(*tracker);
+    }
+    return tracker.get();
+}
+
+void ShardedPeopleTracker::configureTracker(PeopleTracker &tracker)
+{
+    tracker.setVerbose(false);
+    tracker.setListUpdateConstraints(this->person_get_in_track_condition, this->get_in_track_check_frame, this->person_out_of_track_condition);
+    tracker.setTrackThreshold(this->track_distance_threshold);
+    tracker.setSingleTrackResetDistance(this->single_track_reset_distance);
+    tracker.setVelocitySmoothing(this->velocity_smoothing);
+    tracker.setRecordHistory(false);
+}
+
+void ShardedPeopleTracker::assignShards(const std::vector<person> &world, const std::vector<Eigen::Vector3f> &new_center_list)
+{
+    //Sequential pre-pass. A track and a detection closer than the track distance across a tile edge are linked, and so
+    //is everything within the track distance of them in their tiles: the Multi NN match of such a component does not
+    //depend on the rest of the frame, so it goes whole to one shard (the smallest tile of its tracks)
+    int tracks = world.size();
+    int elements = tracks + new_center_list.size();
+    this->element_tiles.resize(elements);
+    this->element_roots.resize(elements);
+    this->tile_tracks.clear();
+    for(int i=0; i < tracks; i++)
+    {
+        this->element_tiles[i] = this->getTile(world[i].points);
+        this->element_roots[i] = i;
+        this->tile_tracks[this->element_tiles[i]].push_back(i);
+    }
+    for(int j=0; j < new_center_list.size(); j++)
+    {
+        this->element_tiles[tracks + j] = this->getTile(new_center_list[j]);
+        this->element_roots[tracks + j] = tracks + j;
+    }
+
+    //Links across tile edges: only detections in the boundary band can have one
+    std::set<shard_tile> linked_tiles;
+    int reach = (int)ceil(this->track_distance_threshold/this->tile_size);
+    for(int j=0; j < new_center_list.size(); j++)
+    {
+        const shard_tile &tile = this->element_tiles[tracks + j];
+        if(!this->inBoundaryBand(new_center_list[j], tile))
+            continue;
+        for(int du=-reach; du <= reach; du++)
+        {
+            for(int dv=-reach; dv <= reach; dv++)
+            {
+                if((du == 0) && (dv == 0))
+                    continue;
+                std::map<shard_tile, std::vector<int> >::iterator it = this->tile_tracks.find(shard_tile(tile.first + du, tile.second + dv));
+                if(it == this->tile_tracks.end())
+                    continue;
+                for(int k=0; k < it->second.size(); k++)
+                {
+                    int i = it->second[k];
+                    if(EuclideanDistance::distance(world[i].points, new_center_list[j]) < this->track_distance_threshold)
+                    {
+                        this->linkElements(i, tracks + j);
+                        linked_tiles.insert(tile);
+                        linked_tiles.insert(it->first);
+                    }
+                }
+            }
+        }
+    }
+    //Links inside the tiles reached by a cross edge
+    for(int j=0; j < new_center_list.size(); j++)
+    {
+        const shard_tile &tile = this->element_tiles[tracks + j];
+        if(linked_tiles.find(tile) == linked_tiles.end())
+            continue;
+        std::map<shard_tile, std::vector<int> >::iterator it = this->tile_tracks.find(tile);
+        if(it == this->tile_tracks.end())
+            continue;
+        for(int k=0; k < it->second.size(); k++)
+        {
+            int i = it->second[k];
+            if(EuclideanDistance::distance(world[i].points, new_center_list[j]) < this->track_distance_threshold)
+                this->linkElements(i, tracks + j);
+        }
+    }
+
+    //Home of a component: the smallest tile of its tracks, a detection without a track stays in its own tile
+    this->component_tiles.assign(elements, shard_tile());
+    this->component_has_track.assign(elements, 0);
+    for(int i=0; i < tracks; i++)
+    {
+        int root = this->findRoot(i);
+        if(!this->component_has_track[root] || (this->element_tiles[i] < this->component_tiles[root]))
+            this->component_tiles[root] = this->element_tiles[i];
+        this->component_has_track[root] = 1;
+    }
+    for(int i=0; i < tracks; i++)
+        this->shards[this->getShard(this->component_tiles[this->findRoot(i)])].world.push_back(world[i]);
+    for(int j=0; j < new_center_list.size(); j++)
+    {
+        int root = this->findRoot(tracks + j);
+        int target = this->getShard(this->component_has_track[root] ? this->component_tiles[root] : this->element_tiles[tracks + j]);
+        this->shards[target].centers.push_back(new_center_list[j]);
+        this->shards[target].confidences.push_back(this->frame_confidences[j]);
+    }
+}
+
+int ShardedPeopleTracker::findRoot(int element)
+{
+    while(this->element_roots[element] != element)
+    {
+        this->element_roots[element] = this->element_roots[this->element_roots[element]];
+        element = this->element_roots[element];
+    }
+    return element;
+}
+
+void ShardedPeopleTracker::linkElements(int a, int b)
+{
+    a = this->findRoot(a);
+    b = this->findRoot(b);
+    if(a < b)
+        this->element_roots[b] = a;
+    else if(b < a)
+        this->element_roots[a] = b;
+}
+
+void ShardedPeopleTracker::runShards(void)
+{
+    this->next_shard = 0;
+    if((this->thread_count <= 1) || (this->shard_count <= 1))
+    {
+        this->processShards();
+        return;
+    }
+    this->start_barrier->wait();
+    this->processShards();
+    this->done_barrier->wait();
+}
+
+void ShardedPeopleTracker::processShards(void)
+{
+    //Shards are pulled one at a time: a crowded tile does not hold back a whole stripe
+    int k;
+    while((k = this->next_shard.fetch_add(1)) < this->shard_count)
+    {
+        tracker_shard &shard = this->shards[k];
+        shard.tracker->resetTrackID();
+        shard.tracker->setFrameStamp(this->frame_stamp);
+        shard.tracker->setFrameConfidences(shard.confidences);
+        shard.tracker->trackPeople(shard.world, shard.centers, this->algorithm, this->list_update_method);
+    }
+}
+
+void ShardedPeopleTracker::workerLoop(void)
+{
+    while(true)
+    {
+        this->start_barrier->wait();
+        if(this->stopping)
+            return;
+        this->processShards();
+        this->done_barrier->wait();
+    }
+}
+
+void ShardedPeopleTracker::recordHistory(const std::vector<person> &world)
+{
+    //Tracks measured (or created) in this frame carry its stamp
+    this->alive_ids.clear();
+    for(int i=0; i < world.size(); i++)
+    {
+        if(world[i].stamp == this->frame_stamp)
+            this->track_history.addSample(world[i].id, world[i].stamp, world[i].points);
+        this->alive_ids.push_back(world[i].id);
+    }
+    this->track_history.retainTracks(this->alive_ids);
+}
+
+void ShardedPeopleTracker::assignNewIds(std::vector<person> &world)
+{
+    //Tracks created by the shard in this frame, in its list order
+    for(int i=0; i < world.size(); i++)
+    {
+        if(world[i].id < 0)
+            world[i].id = this->id_allocator->allocate();
+    }
+}
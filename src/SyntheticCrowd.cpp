@@ -0,0 +1,311 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <SyntheticCrowd.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdlib.h>
+
+
+//Public Function
+SyntheticCrowd::SyntheticCrowd(Eigen::Matrix3f rgb_intrinsics_matrix, int width, int height, float camera_height)
+{
+    this->intrinsics = rgb_intrinsics_matrix;
+    this->width = width;
+    this->height = height;
+    this->camera_height = camera_height;
+    this->max_range = DEFAULT_SYNTHETIC_MAX_RANGE;
+    this->noise_coeff = 0.0f;
+    this->noise_seed = 1;
+
+    //Pixel rays with z = 1: the ray parameter is the depth
+    Eigen::Matrix3f inv = rgb_intrinsics_matrix.inverse();
+    this->rays.resize(width*height);
+    for(int v=0; v < height; v++)
+        for(int u=0; u < width; u++)
+            this->rays[v*width + u] = inv*Eigen::Vector3f(u, v, 1.0f);
+    this->depth_buffer.resize(width*height);
+}
+
+void SyntheticCrowd::setMaxRange(float range)
+{
+    this->max_range = range;
+}
+
+void SyntheticCrowd::setDepthNoise(float noise_coeff)
+{
+    this->noise_coeff = noise_coeff;
+}
+
+void SyntheticCrowd::addPerson(const synthetic_person &p)
+{
+    this->people.push_back(p);
+}
+
+void SyntheticCrowd::addBox(const synthetic_box &b)
+{
+    this->boxes.push_back(b);
+}
+
+void SyntheticCrowd::clear(void)
+{
+    this->people.clear();
+    this->boxes.clear();
+}
+
+void SyntheticCrowd::addRandomCrowd(int n_people, float x_range, float z_min, float z_max, unsigned int seed)
+{
+    int first_id = this->people.size() + 1;
+    for(int i=0; i < n_people; i++)
+    {
+        synthetic_person p;
+        p.id = first_id + i;
+        p.height = 1.5f + 0.45f*rand_r(&seed)/RAND_MAX;
+        p.radius = 0.18f + 0.07f*rand_r(&seed)/RAND_MAX;
+        p.speed = 0.3f + 1.1f*rand_r(&seed)/RAND_MAX;
+        int n_waypoints = 2 + rand_r(&seed) % 3;
+        for(int w=0; w < n_waypoints; w++)
+        {
+            float x = -x_range + 2.0f*x_range*rand_r(&seed)/RAND_MAX;
+            float z = z_min + (z_max - z_min)*rand_r(&seed)/RAND_MAX;
+            p.waypoints.push_back(Eigen::Vector3f(x, 0.0f, z));
+        }
+        p.color << rand_r(&seed) % 256, rand_r(&seed) % 256, rand_r(&seed) % 256;
+        this->people.push_back(p);
+    }
+}
+
+void SyntheticCrowd::addRandomClutter(int n_boxes, float x_range, float z_min, float z_max, unsigned int seed)
+{
+    for(int i=0; i < n_boxes; i++)
+    {
+        synthetic_box b;
+        float x = -x_range + 2.0f*x_range*rand_r(&seed)/RAND_MAX;
+        float z = z_min + (z_max - z_min)*rand_r(&seed)/RAND_MAX;
+        float sx = 0.2f + 0.6f*rand_r(&seed)/RAND_MAX;
+        float sz = 0.2f + 0.6f*rand_r(&seed)/RAND_MAX;
+        float sy = 0.3f + 0.9f*rand_r(&seed)/RAND_MAX;
+        b.min_corner << x - sx/2, this->camera_height - sy, z - sz/2;
+        b.max_corner << x + sx/2, this->camera_height, z + sz/2;
+        b.color << rand_r(&seed) % 256, rand_r(&seed) % 256, rand_r(&seed) % 256;
+        this->boxes.push_back(b);
+    }
+}
+
+void SyntheticCrowd::generate(double t, pcl::PointCloud<pcl::PointXYZRGBA> &cloud, std::vector<synthetic_ground_truth> &ground_truth)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const Eigen::Vector3f ground_color(128, 128, 128);
+    const Eigen::Vector3f skin_color(224, 172, 105);
+    const Eigen::Vector3f pants_color(40, 40, 80);
+    cloud.width = this->width;
+    cloud.height = this->height;
+    cloud.is_dense = false;
+    cloud.points.resize(this->width*this->height);
+    ground_truth.clear();
+
+    //Floor and clutter for every pixel
+    for(int i=0; i < this->rays.size(); i++)
+    {
+        const Eigen::Vector3f &ray = this->rays[i];
+        float best = this->max_range;
+        Eigen::Vector3f color = ground_color;
+        if(ray(1) > 0.0f)
+        {
+            best = this->camera_height/ray(1);
+            //Floor tiles give the image some texture
+            int tile = ((int)floor(ray(0)*best*2.0f) + (int)floor(best*2.0f)) & 1;
+            color = ground_color*(tile ? 1.0f : 0.8f);
+        }
+        for(int b=0; b < this->boxes.size(); b++)
+        {
+            float tb = this->rayBox(ray, this->boxes[b]);
+            if(tb < best)
+            {
+                best = tb;
+                color = this->boxes[b].color;
+            }
+        }
+        this->depth_buffer[i] = best;
+        if(best < this->max_range)
+            this->setPoint(cloud.points[i], ray, best, color);
+        else
+        {
+            pcl::PointXYZRGBA &pt = cloud.points[i];
+            pt.x = pt.y = pt.z = nan;
+            pt.rgba = 0;
+        }
+    }
+
+    //People: only the pixels inside each projected bounding box
+    for(int k=0; k < this->people.size(); k++)
+    {
+        const synthetic_person &p = this->people[k];
+        Eigen::Vector3f position = this->getPersonPosition(p, t);
+        float extent = std::max(p.radius, (float)DEFAULT_SYNTHETIC_HEAD_RADIUS);
+        if(position(2) - extent <= 0.1f)
+            continue;
+        Eigen::Vector3f center(position(0), this->camera_height - p.height/2, position(2));
+        Eigen::Vector3f center_px = this->intrinsics*center;
+        center_px /= center_px(2);
+        if((position(2) < this->max_range) && (center_px(0) >= 0) && (center_px(0) < this->width) &&
+           (center_px(1) >= 0) && (center_px(1) < this->height))
+        {
+            synthetic_ground_truth gt;
+            gt.id = p.id;
+            gt.center = center;
+            ground_truth.push_back(gt);
+        }
+
+        //Bounding box of the person's x-z square over its height range: the projection of its 8 corners bounds the
+        //silhouette (the near face alone misses the side facing the optical axis for people off the axis)
+        float u_min = std::numeric_limits<float>::max(), u_max = -std::numeric_limits<float>::max();
+        float v_min = std::numeric_limits<float>::max(), v_max = -std::numeric_limits<float>::max();
+        for(int corner=0; corner < 8; corner++)
+        {
+            Eigen::Vector3f px = this->intrinsics*Eigen::Vector3f(position(0) + ((corner & 1) ? extent : -extent),
+                                                                  (corner & 2) ? this->camera_height : this->camera_height - p.height,
+                                                                  position(2) + ((corner & 4) ? extent : -extent));
+            u_min = std::min(u_min, px(0)/px(2));
+            u_max = std::max(u_max, px(0)/px(2));
+            v_min = std::min(v_min, px(1)/px(2));
+            v_max = std::max(v_max, px(1)/px(2));
+        }
+        int u0 = std::max(0, (int)floor(u_min));
+        int v0 = std::max(0, (int)floor(v_min));
+        int u1 = std::min(this->width - 1, (int)ceil(u_max));
+        int v1 = std::min(this->height - 1, (int)ceil(v_max));
+        for(int v=v0; v <= v1; v++)
+        {
+            for(int u=u0; u <= u1; u++)
+            {
+                int i = v*this->width + u;
+                bool head;
+                float tp = this->rayPerson(this->rays[i], p, position, head);
+                if(tp >= this->depth_buffer[i])
+                    continue;
+                this->depth_buffer[i] = tp;
+                float y = this->rays[i](1)*tp;
+                bool legs = (y > this->camera_height - 0.45f*p.height);
+                this->setPoint(cloud.points[i], this->rays[i], tp, head ? skin_color : (legs ? pants_color : p.color));
+            }
+        }
+    }
+}
+
+Eigen::Vector3f SyntheticCrowd::getPersonPosition(const synthetic_person &p, double t)
+{
+    //Back and forth along the waypoint polyline
+    if(p.waypoints.size() < 2)
+        return p.waypoints.empty() ? Eigen::Vector3f::Zero() : p.waypoints[0];
+    float length = 0.0f;
+    for(int w=1; w < p.waypoints.size(); w++)
+        length += (p.waypoints[w] - p.waypoints[w-1]).norm();
+    if(length <= 0.0f)
+        return p.waypoints[0];
+    float s = fmod(p.speed*t, 2.0*length);
+    if(s > length)
+        s = 2.0f*length - s;
+    for(int w=1; w < p.waypoints.size(); w++)
+    {
+        float seg = (p.waypoints[w] - p.waypoints[w-1]).norm();
+        if((s <= seg) && (seg > 0.0f))
+            return p.waypoints[w-1] + (p.waypoints[w] - p.waypoints[w-1])*(s/seg);
+        s -= seg;
+    }
+    return p.waypoints.back();
+}
+
+Eigen::VectorXf SyntheticCrowd::getGroundCoeffs(void)
+{
+    //Normal pointing up (-y in the optical frame): points above the floor are positive
+    Eigen::VectorXf coeffs(4);
+    coeffs << 0.0f, -1.0f, 0.0f, this->camera_height;
+    return coeffs;
+}
+
+
+//Private Function---------------------------------------------------------
+
+float SyntheticCrowd::rayPerson(const Eigen::Vector3f &ray, const synthetic_person &p, const Eigen::Vector3f &position, bool &head)
+{
+    const float head_radius = DEFAULT_SYNTHETIC_HEAD_RADIUS;
+    float best = std::numeric_limits<float>::max();
+    head = false;
+
+    //Body cylinder around the vertical axis through position, from the floor to the neck
+    float a = ray(0)*ray(0) + ray(2)*ray(2);
+    float b = -2.0f*(ray(0)*position(0) + ray(2)*position(2));
+    float c = position(0)*position(0) + position(2)*position(2) - p.radius*p.radius;
+    float disc = b*b - 4.0f*a*c;
+    if(disc >= 0.0f)
+    {
+        float t = (-b - sqrt(disc))/(2.0f*a);
+        float y = ray(1)*t;
+        if((t > 0.0f) && (y <= this->camera_height) && (y >= this->camera_height - p.height + 2.0f*head_radius))
+            best = t;
+    }
+
+    //Head sphere on top
+    Eigen::Vector3f head_center(position(0), this->camera_height - p.height + head_radius, position(2));
+    a = ray.squaredNorm();
+    b = -2.0f*ray.dot(head_center);
+    c = head_center.squaredNorm() - head_radius*head_radius;
+    disc = b*b - 4.0f*a*c;
+    if(disc >= 0.0f)
+    {
+        float t = (-b - sqrt(disc))/(2.0f*a);
+        if((t > 0.0f) && (t < best))
+        {
+            best = t;
+            head = true;
+        }
+    }
+    return best;
+}
+
+float SyntheticCrowd::rayBox(const Eigen::Vector3f &ray, const synthetic_box &b)
+{
+    //Slab test from the camera origin
+    float t_near = 0.0f;
+    float t_far = std::numeric_limits<float>::max();
+    for(int k=0; k < 3; k++)
+    {
+        if(fabs(ray(k)) < 1e-9f)
+        {
+            if((b.min_corner(k) > 0.0f) || (b.max_corner(k) < 0.0f))
+                return std::numeric_limits<float>::max();
+            continue;
+        }
+        float t0 = b.min_corner(k)/ray(k);
+        float t1 = b.max_corner(k)/ray(k);
+        if(t0 > t1)
+            std::swap(t0, t1);
+        t_near = std::max(t_near, t0);
+        t_far = std::min(t_far, t1);
+        if(t_near > t_far)
+            return std::numeric_limits<float>::max();
+    }
+    return (t_near > 0.0f) ? t_near : std::numeric_limits<float>::max();
+}
+
+float SyntheticCrowd::gaussianNoise(void)
+{
+    //Box-Muller
+    float u1 = (rand_r(&this->noise_seed) + 1.0f)/(RAND_MAX + 2.0f);
+    float u2 = (rand_r(&this->noise_seed) + 1.0f)/(RAND_MAX + 2.0f);
+    return sqrt(-2.0f*log(u1))*cos(2.0f*M_PI*u2);
+}
+
+void SyntheticCrowd::setPoint(pcl::PointXYZRGBA &pt, const Eigen::Vector3f &ray, float t, const Eigen::Vector3f &color)
+{
+    if(this->noise_coeff > 0.0f)
+        t += this->noise_coeff*t*t*this->gaussianNoise();
+    pt.x = ray(0)*t;
+    pt.y = ray(1)*t;
+    pt.z = t;
+    uint32_t rgb = ((uint32_t)color(0) << 16) | ((uint32_t)color(1) << 8) | (uint32_t)color(2);
+    pt.rgba = rgb | 0xff000000;
+}
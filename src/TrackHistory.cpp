@@ -0,0 +1,157 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <TrackHistory.h>
+
+
+//Public Function
+TrackHistory::TrackHistory(int max_tracks, int capacity)
+{
+    this->setCapacity(max_tracks, capacity);
+}
+
+void TrackHistory::setCapacity(int max_tracks, int capacity)
+{
+    boost::mutex::scoped_lock lock(this->history_mutex);
+    this->max_tracks = (max_tracks > 0) ? max_tracks : 1;
+    this->capacity = (capacity > 0) ? capacity : 1;
+    this->pool.assign(this->max_tracks*this->capacity, track_sample());
+    this->slot_id.assign(this->max_tracks, -1);
+    this->slot_head.assign(this->max_tracks, 0);
+    this->slot_size.assign(this->max_tracks, 0);
+}
+
+void TrackHistory::addSample(int id, double stamp, const Eigen::Vector3f &points)
+{
+    boost::mutex::scoped_lock lock(this->history_mutex);
+    int slot = this->findSlot(id);
+    if(slot < 0)
+        slot = this->allocateSlot(id);
+
+    track_sample &sample = this->pool[slot*this->capacity + this->slot_head[slot]];
+    sample.stamp = stamp;
+    sample.points = points;
+    this->slot_head[slot] = (this->slot_head[slot] + 1) % this->capacity;
+    if(this->slot_size[slot] < this->capacity)
+        this->slot_size[slot]++;
+}
+
+void TrackHistory::retainTracks(const std::vector<int> &alive_ids)
+{
+    boost::mutex::scoped_lock lock(this->history_mutex);
+    for(int s=0; s < this->max_tracks; s++)
+    {
+        if(this->slot_id[s] < 0)
+            continue;
+        bool alive = false;
+        for(int i=0; i < alive_ids.size(); i++)
+        {
+            if(alive_ids[i] == this->slot_id[s])
+            {
+                alive = true;
+                break;
+            }
+        }
+        if(!alive)
+        {
+            this->slot_id[s] = -1;
+            this->slot_size[s] = 0;
+            this->slot_head[s] = 0;
+        }
+    }
+}
+
+void TrackHistory::clear(void)
+{
+    boost::mutex::scoped_lock lock(this->history_mutex);
+    this->slot_id.assign(this->max_tracks, -1);
+    this->slot_head.assign(this->max_tracks, 0);
+    this->slot_size.assign(this->max_tracks, 0);
+}
+
+bool TrackHistory::getTrack(int id, double since, std::vector<track_sample> &samples)
+{
+    boost::mutex::scoped_lock lock(this->history_mutex);
+    samples.clear();
+    int slot = this->findSlot(id);
+    if(slot < 0)
+        return false;
+    for(int i=0; i < this->slot_size[slot]; i++)
+    {
+        const track_sample &sample = this->sampleAt(slot, i);
+        if(sample.stamp >= since)
+            samples.push_back(sample);
+    }
+    return true;
+}
+
+void TrackHistory::getTracksWithinRadius(const Eigen::Vector3f &center, float radius, double since, std::vector<int> &ids)
+{
+    boost::mutex::scoped_lock lock(this->history_mutex);
+    ids.clear();
+    float radius2 = radius*radius;
+    for(int s=0; s < this->max_tracks; s++)
+    {
+        if(this->slot_id[s] < 0)
+            continue;
+        //Newest first: stop at the first sample older than since
+        for(int i=this->slot_size[s]-1; i >= 0; i--)
+        {
+            const track_sample &sample = this->sampleAt(s, i);
+            if(sample.stamp < since)
+                break;
+            if((sample.points - center).squaredNorm() <= radius2)
+            {
+                ids.push_back(this->slot_id[s]);
+                break;
+            }
+        }
+    }
+}
+
+
+//Private Function---------------------------------------------------------
+
+int TrackHistory::findSlot(int id)
+{
+    for(int s=0; s < this->max_tracks; s++)
+    {
+        if(this->slot_id[s] == id)
+            return s;
+    }
+    return -1;
+}
+
+int TrackHistory::allocateSlot(int id)
+{
+    //Take a free slot, if the pool is full evict the track with the oldest last sample
+    int slot = -1;
+    double oldest = 0.0;
+    for(int s=0; s < this->max_tracks; s++)
+    {
+        if(this->slot_id[s] < 0)
+        {
+            slot = s;
+            break;
+        }
+        double last = this->sampleAt(s, this->slot_size[s]-1).stamp;
+        if((slot < 0) || (last < oldest))
+        {
+            slot = s;
+            oldest = last;
+        }
+    }
+    this->slot_id[slot] = id;
+    this->slot_head[slot] = 0;
+    this->slot_size[slot] = 0;
+    return slot;
+}
+
+const track_sample& TrackHistory::sampleAt(int slot, int i)
+{
+    int start = this->slot_head[slot] - this->slot_size[slot];
+    if(start < 0)
+        start += this->capacity;
+    return this->pool[slot*this->capacity + (start + i) % this->capacity];
+}
@@ -0,0 +1,25 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <TrackIdAllocator.h>
+
+
+TrackIdAllocator::TrackIdAllocator(int first_id) : first_id(first_id), next_id(first_id)
+{
+}
+
+int TrackIdAllocator::allocate(void)
+{
+    return this->next_id.fetch_add(1, boost::memory_order_relaxed);
+}
+
+int TrackIdAllocator::peek(void)
+{
+    return this->next_id.load(boost::memory_order_relaxed);
+}
+
+void TrackIdAllocator::reset(void)
+{
+    this->next_id.store(this->first_id, boost::memory_order_relaxed);
+}
@@ -0,0 +1,184 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <TrackerContext.h>
+
+
+//Public Function
+TrackerContext::TrackerContext()
+{
+    this->id_allocator.reset(new TrackIdAllocator);
+    this->track_distance_threshold = 0.3;
+    this->single_track_reset_distance = 1.0;
+    this->person_get_in_track_condition = DEFAULT_GET_IN_TRACK_CONDITION;
+    this->get_in_track_check_frame = DEFAULT_GET_IN_TRACK_CHECK_FRAME;
+    this->person_out_of_track_condition = DEFAULT_OUT_OF_TRACK_CONDITION;
+    this->velocity_smoothing = DEFAULT_VELOCITY_SMOOTHING;
+    this->frame_stamp = 0.0;
+    this->color_seed = 1;
+    this->record_history = true;
+}
+
+void TrackerContext::setListUpdateConstraints(int getin, int getincheck, int getout)
+{
+    this->person_get_in_track_condition = getin;
+    this->get_in_track_check_frame = getincheck;
+    this->person_out_of_track_condition = getout;
+}
+
+void TrackerContext::setTrackThreshold(float distTH)
+{
+    this->track_distance_threshold = distTH;
+}
+
+void TrackerContext::setSingleTrackResetDistance(float distTH)
+{
+    this->single_track_reset_distance = distTH;
+}
+
+void TrackerContext::setFrameStamp(double stamp)
+{
+    this->frame_stamp = stamp;
+}
+
+bool TrackerContext::setVelocitySmoothing(float alpha)
+{
+    //alpha = weight of the newest velocity sample, 1.0 means no smoothing
+    if(alpha <= 0.0f || alpha > 1.0f)
+        return false;
+    this->velocity_smoothing = alpha;
+    return true;
+}
+
+void TrackerContext::setFrameConfidences(const std::vector<float> &confidences)
+{
+    this->frame_confidences = confidences;
+}
+
+void TrackerContext::resetTrackID(void)
+{
+    this->id_allocator->reset();
+}
+
+void TrackerContext::setIdAllocator(boost::shared_ptr<TrackIdAllocator> allocator)
+{
+    this->id_allocator = allocator;
+}
+
+TrackHistory& TrackerContext::getTrackHistory(void)
+{
+    return this->track_history;
+}
+
+void TrackerContext::setHistoryCapacity(int max_tracks, int samples_per_track)
+{
+    this->track_history.setCapacity(max_tracks, samples_per_track);
+}
+
+void TrackerContext::setRecordHistory(bool enable)
+{
+    this->record_history = enable;
+}
+
+Eigen::Vector3f TrackerContext::extrapolatePosition(const person &p, double stamp, double max_horizon)
+{
+    //Constant velocity prediction from the last measurement, clamped to max_horizon seconds
+    double dt = stamp - p.stamp;
+    if(dt <= 0.0)
+        return p.points;
+    if(dt > max_horizon)
+        dt = max_horizon;
+    return p.points + p.velocity*(float)dt;
+}
+
+void TrackerContext::beginFrame(const std::vector<Eigen::Vector3f> &new_center_list)
+{
+    //Kept to look up the confidence of matched centers
+    this->frame_centers = new_center_list;
+    if(this->frame_confidences.size() != this->frame_centers.size())
+        this->frame_confidences.assign(this->frame_centers.size(), 0.0f);
+}
+
+void TrackerContext::endFrame(const std::vector<person> &world)
+{
+    if(this->record_history)
+    {
+        this->alive_ids.clear();
+        for(int i=0; i < world.size(); i++)
+            this->alive_ids.push_back(world[i].id);
+        this->track_history.retainTracks(this->alive_ids);
+    }
+    this->frame_confidences.clear();
+}
+
+person TrackerContext::createNewPerson(const Eigen::Vector3f &center_points, bool id_increment)
+{
+    person temp;
+    temp.points = center_points;
+    temp.velocity = Eigen::Vector3f::Zero();
+    temp.stamp = this->frame_stamp;
+    float init_var = DEFAULT_INITIAL_POSITION_STDDEV*DEFAULT_INITIAL_POSITION_STDDEV;
+    temp.variance << init_var, init_var, init_var;
+    temp.confidence = this->getFrameConfidence(center_points);
+    //Single NN keeps one track: it reuses the next id instead of taking it
+    temp.id = id_increment ? this->id_allocator->allocate() : this->id_allocator->peek();
+    temp.framesage = 0;
+    temp.outcount = this->person_out_of_track_condition;
+    temp.incount = this->person_get_in_track_condition;
+    temp.istrack = false;
+    temp.color = this->generateTrackerColor();
+    if(this->record_history)
+        this->track_history.addSample(temp.id, temp.stamp, temp.points);
+    return temp;
+}
+
+void TrackerContext::updatePersonMeasurement(person &p, const Eigen::Vector3f &center_points)
+{
+    double dt = this->frame_stamp - p.stamp;
+    if((dt > 0.0) && (dt <= DEFAULT_MAX_VELOCITY_GAP))
+    {
+        //Residual against the constant velocity prediction feeds the position variance
+        Eigen::Vector3f residual = center_points - extrapolatePosition(p, this->frame_stamp, DEFAULT_MAX_VELOCITY_GAP);
+        p.variance = DEFAULT_VARIANCE_SMOOTHING*residual.cwiseProduct(residual) + (1.0f - DEFAULT_VARIANCE_SMOOTHING)*p.variance;
+
+        Eigen::Vector3f raw_velocity = (center_points - p.points)/(float)dt;
+        p.velocity = this->velocity_smoothing*raw_velocity + (1.0f - this->velocity_smoothing)*p.velocity;
+    }
+    else if(dt > DEFAULT_MAX_VELOCITY_GAP)
+    {
+        p.velocity = Eigen::Vector3f::Zero(); //Re-acquired after a long gap: difference is not a velocity
+    }
+    p.points = center_points;
+    p.stamp = this->frame_stamp;
+    p.confidence = this->getFrameConfidence(center_points);
+    if(this->record_history)
+        this->track_history.addSample(p.id, p.stamp, p.points);
+}
+
+
+//Private Function---------------------------------------------------------
+
+float TrackerContext::getFrameConfidence(const Eigen::Vector3f &center_points)
+{
+    //Matched centers are copied untouched from the frame list, so exact comparison is enough
+    for(int i=0; i < this->frame_centers.size(); i++)
+    {
+        if(this->frame_centers[i] == center_points)
+            return this->frame_confidences[i];
+    }
+    return 0.0f;
+}
+
+Eigen::Vector3f TrackerContext::generateTrackerColor()
+{
+    Eigen::Vector3f color;
+    //rand_r on a per tracker seed: trackers in different threads do not share the rand() state
+    float r = ((double) rand_r(&this->color_seed) / (RAND_MAX));
+    float g = ((double) rand_r(&this->color_seed) / (RAND_MAX));
+    float b = ((double) rand_r(&this->color_seed) / (RAND_MAX));
+    color(0) = r;
+    color(1) = g;
+    color(2) = b;
+    return color;
+}
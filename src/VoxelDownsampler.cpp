@@ -0,0 +1,225 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+
+#include <VoxelDownsampler.h>
+#include <algorithm>
+#include <boost/bind.hpp>
+
+
+//Public Function
+VoxelDownsampler::VoxelDownsampler(int threads) : next_chunk(0), stopping(false)
+{
+    this->input = NULL;
+    this->inverse_leaf = 1.0f;
+    this->chunk_count = 0;
+    this->chunk_size = 0;
+
+    if(threads <= 0)
+        threads = boost::thread::hardware_concurrency();
+    this->thread_count = (threads > 0) ? threads : 1;
+    this->tables.resize(this->thread_count);
+    for(int i=0; i < this->tables.size(); i++)
+    {
+        voxel_table &table = this->tables[i];
+        voxel_accumulator empty;
+        empty.count = 0;
+        table.slots.assign(DEFAULT_VOXEL_TABLE_SIZE, empty);
+        table.bits = 0;
+        while((1 << table.bits) < DEFAULT_VOXEL_TABLE_SIZE)
+            table.bits++;
+    }
+    if(this->thread_count > 1)
+    {
+        this->start_barrier.reset(new boost::barrier(this->thread_count));
+        this->done_barrier.reset(new boost::barrier(this->thread_count));
+        for(int i=1; i < this->thread_count; i++)
+            this->workers.create_thread(boost::bind(&VoxelDownsampler::workerLoop, this));
+    }
+}
+
+VoxelDownsampler::~VoxelDownsampler()
+{
+    if(this->thread_count > 1)
+    {
+        this->stopping = true;
+        this->start_barrier->wait();
+        this->workers.join_all();
+    }
+}
+
+int VoxelDownsampler::getThreadCount(void)
+{
+    return this->thread_count;
+}
+
+void VoxelDownsampler::downsample(const std::vector<compact_point> &in, float leaf_size, std::vector<compact_point> &out)
+{
+    out.clear();
+    if(in.empty())
+        return;
+    this->input = &in;
+    this->inverse_leaf = 1.0f/(leaf_size*1000.0f);
+    this->chunk_count = std::min<int>(this->thread_count, (in.size() + DEFAULT_VOXEL_MIN_CHUNK - 1)/DEFAULT_VOXEL_MIN_CHUNK);
+    this->chunk_size = (in.size() + this->chunk_count - 1)/this->chunk_count;
+    this->runChunks();
+
+    //Merge: a voxel cut by a chunk boundary has one partial sum per chunk
+    this->merged.clear();
+    for(int c=0; c < this->chunk_count; c++)
+    {
+        voxel_table &table = this->tables[c];
+        for(int k=0; k < table.used.size(); k++)
+            this->merged.push_back(table.slots[table.used[k]]);
+    }
+    std::sort(this->merged.begin(), this->merged.end(), accumulatorLess);
+    int first = 0;
+    while(first < this->merged.size())
+    {
+        voxel_accumulator voxel = this->merged[first];
+        int last = first + 1;
+        while((last < this->merged.size()) && (this->merged[last].key == voxel.key))
+        {
+            const voxel_accumulator &part = this->merged[last];
+            for(int k=0; k < 3; k++)
+            {
+                voxel.sum[k] += part.sum[k];
+                voxel.color[k] += part.color[k];
+            }
+            voxel.count += part.count;
+            last++;
+        }
+        compact_point centroid;
+        centroid.x = (int16_t)lrint((double)voxel.sum[0]/voxel.count);
+        centroid.y = (int16_t)lrint((double)voxel.sum[1]/voxel.count);
+        centroid.z = (int16_t)lrint((double)voxel.sum[2]/voxel.count);
+        centroid.r = voxel.color[0]/voxel.count;
+        centroid.g = voxel.color[1]/voxel.count;
+        centroid.b = voxel.color[2]/voxel.count;
+        centroid.reserved = 0;
+        out.push_back(centroid);
+        first = last;
+    }
+    this->input = NULL;
+}
+
+
+//Private Function---------------------------------------------------------
+
+int64_t VoxelDownsampler::voxelKey(int64_t ix, int64_t iy, int64_t iz)
+{
+    //21 bits per axis: int16 mm coordinates give at most 65536 voxels per axis
+    const int64_t offset = 1 << 20;
+    return ((iz + offset) << 42) | ((iy + offset) << 21) | (ix + offset);
+}
+
+void VoxelDownsampler::clearTable(voxel_table &table)
+{
+    for(int k=0; k < table.used.size(); k++)
+        table.slots[table.used[k]].count = 0;
+    table.used.clear();
+}
+
+void VoxelDownsampler::growTable(voxel_table &table)
+{
+    std::vector<voxel_accumulator> old_slots;
+    std::vector<int> old_used;
+    old_slots.swap(table.slots);
+    old_used.swap(table.used);
+    voxel_accumulator empty;
+    empty.count = 0;
+    table.bits++;
+    table.slots.assign(1 << table.bits, empty);
+    for(int k=0; k < old_used.size(); k++)
+    {
+        const voxel_accumulator &voxel = old_slots[old_used[k]];
+        findSlot(table, voxel.key) = voxel;
+    }
+}
+
+voxel_accumulator& VoxelDownsampler::findSlot(voxel_table &table, int64_t key)
+{
+    //Fibonacci hashing, linear probing. An empty slot found is claimed for key
+    int mask = (1 << table.bits) - 1;
+    int slot = (int)(((uint64_t)key*0x9E3779B97F4A7C15ull) >> (64 - table.bits));
+    while(true)
+    {
+        voxel_accumulator &voxel = table.slots[slot];
+        if(voxel.count == 0)
+        {
+            voxel.key = key;
+            voxel.sum[0] = voxel.sum[1] = voxel.sum[2] = 0;
+            voxel.color[0] = voxel.color[1] = voxel.color[2] = 0;
+            table.used.push_back(slot);
+            return voxel;
+        }
+        if(voxel.key == key)
+            return voxel;
+        slot = (slot + 1) & mask;
+    }
+}
+
+void VoxelDownsampler::accumulateChunk(int chunk)
+{
+    const std::vector<compact_point> &in = *this->input;
+    voxel_table &table = this->tables[chunk];
+    clearTable(table);
+    int begin = chunk*this->chunk_size;
+    int end = std::min<int>(begin + this->chunk_size, in.size());
+    int64_t last_key = 0;
+    voxel_accumulator *last = NULL;
+    for(int i=begin; i < end; i++)
+    {
+        const compact_point &p = in[i];
+        //Same voxel index as CompactCloudFilter::voxelDownsample
+        int64_t key = voxelKey((int64_t)floorf(p.x*this->inverse_leaf), (int64_t)floorf(p.y*this->inverse_leaf),
+                               (int64_t)floorf(p.z*this->inverse_leaf));
+        //Neighbor pixels mostly share a voxel: skip the lookup
+        if((last == NULL) || (key != last_key))
+        {
+            if(2*(table.used.size() + 1) > table.slots.size())
+                growTable(table);
+            last = &findSlot(table, key);
+            last_key = key;
+        }
+        last->sum[0] += p.x;
+        last->sum[1] += p.y;
+        last->sum[2] += p.z;
+        last->color[0] += p.r;
+        last->color[1] += p.g;
+        last->color[2] += p.b;
+        last->count++;
+    }
+}
+
+void VoxelDownsampler::runChunks(void)
+{
+    this->next_chunk = 0;
+    if((this->thread_count <= 1) || (this->chunk_count <= 1))
+    {
+        this->processChunks();
+        return;
+    }
+    this->start_barrier->wait();
+    this->processChunks();
+    this->done_barrier->wait();
+}
+
+void VoxelDownsampler::processChunks(void)
+{
+    int k;
+    while((k = this->next_chunk.fetch_add(1)) < this->chunk_count)
+        this->accumulateChunk(k);
+}
+
+void VoxelDownsampler::workerLoop(void)
+{
+    while(true)
+    {
+        this->start_barrier->wait();
+        if(this->stopping)
+            return;
+        this->processChunks();
+        this->done_barrier->wait();
+    }
+}
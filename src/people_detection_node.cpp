@@ -4,23 +4,47 @@
 
 #include <cstdlib>
 #include "ros/ros.h"
+#include <ros/callback_queue.h>
 #include <sensor_msgs/PointCloud2.h>
+#include <boost/thread/mutex.hpp>
+#include <boost/atomic.hpp>
+#include <map>
 #include "PeopleDetector.h"
 #include "PeopleTracker.h"
 
 #include <people_detection/PersonObject.h>
 #include <people_detection/PersonObjectArray.h>
+#include <people_detection/TrackedPersonArray.h>
+#include <people_detection/GetTrackHistory.h>
+#include <people_detection/PeopleDensityGrid.h>
+#include <people_detection/GetPeopleDensity.h>
 //#include <people_detection/ClearPeopleTracker.h>
 
 #include <actionlib/server/simple_action_server.h>
+#include <dynamic_reconfigure/server.h>
+#include <people_detection/PeopleDetectionConfig.h>
 #include <people_detection/ReInitTrackingAction.h>
 #include <people_detection/PausePeopleDetectionAction.h>
 #include <PeopleTracker.h>
+#include <ShardedPeopleTracker.h>
+#include <DetectionLog.h>
+#include <PeopleDensityGrid.h>
 
 
 #define DEFAULT_CLOUD_TOPIC "/camera/depth_registered/points"
 #define DEFAULT_CAM_LINK "camera_rgb_optical_frame"
 #define DEFAULT_ROBOT_LINK "base_link"
+#define DEFAULT_MAX_EXTRAPOLATION_TIME 0.5
+#define DEFAULT_TF_TIMEOUT 0.05
+#define DEFAULT_TRACK_PUBLISH_RATE 0.0
+#define DEFAULT_INTERPOLATION_TIME 0.1
+#define DEFAULT_DELTA_KEYFRAME_INTERVAL 30
+#define DEFAULT_HISTORY_DURATION 10.0
+#define DEFAULT_HISTORY_FRAME_RATE 30.0 //Hz, Kinect
+#define DEFAULT_CLOUD_WIDTH 640
+#define DEFAULT_CLOUD_HEIGHT 480
+#define DEFAULT_MAX_PEOPLE 32
+#define DEFAULT_DENSITY_GRID_PUBLISH_RATE 0.0
 
 typedef pcl::PointXYZRGBA PointT;
 typedef pcl::PointCloud<PointT> PointCloudT;
@@ -33,16 +57,48 @@ class PeopleDetectionRunner{
     private:
         ros::NodeHandle nh;
         ros::Publisher people_array_pub;
+        ros::Publisher track_array_pub;
+        bool track_array_delta;
+        int delta_keyframe_interval;
+        int frames_since_keyframe;
+        std::map<int, double> published_track_stamp; //last published measurement stamp per id, for DELTA mode
+        std::map<int, bool> published_track_state;
         //ros::ServiceServer service;
-        PointCloudT::Ptr cloud_obj;
+        ros::ServiceServer track_history_srv;
+        boost::mutex history_time_mutex;
+        ros::Time history_stamp; //cloud stamp of the last tracked frame: history queries run on sensor time
+        ros::Time history_processed; //ros::Time::now() when it was tracked
+        //People density grid: updated by execute() from the track changes, published and queried on the control thread
+        PeopleDensityGrid density_grid;
+        double density_grid_publish_rate;
+        std::string density_grid_frame;
+        ros::Publisher density_grid_pub;
+        ros::Timer density_grid_timer;
+        ros::ServiceServer people_density_srv;
+        std::vector<int> density_grid_ids;
+        std::vector<Eigen::Vector2f> density_grid_positions;
+        boost::mutex density_grid_time_mutex;
+        ros::Time density_grid_stamp; //cloud stamp of the last update: the grid runs on sensor time
+        ros::Time density_grid_processed; //ros::Time::now() at that update
+        PointCloudT::Ptr cloud_obj; //full cloud: input of the pcl pipeline, viewer only with the compact one
+        CompactCloud compact_cloud;
+        bool compact_pipeline;
+        ros::Time cloud_stamp; //acquisition time of cloud_obj
         ros::Subscriber cloub_sub;
         bool new_cloud_available_flag;
         PeopleDetector ppl_detector;
         PeopleTracker ppl_tracker;
+        boost::shared_ptr<ShardedPeopleTracker> sharded_tracker; //set when sharded_tracking is on
         std::vector<person> world_track_list;
         //pcl::visualization::PCLVisualizer viewer;
-        pcl::visualization::PCLVisualizer::Ptr viewer;
-        bool init_cam_frame;
+        pcl::visualization::PCLVisualizer::Ptr viewer; //created on the first frame drawn
+        std::vector<Eigen::Vector3f> center_buffer;
+        std::vector<float> confidence_buffer;
+        ros::WallTime startup_time;
+        ros::WallTime first_cloud_time;
+        bool first_detection_done;
+        DetectionLogWriter detection_log;
+        boost::atomic<bool> init_cam_frame;
         std::string camera_frame;
         std::string robot_ref_frame;
         bool ui_enable;
@@ -51,25 +107,60 @@ class PeopleDetectionRunner{
         int out_of_track;
         int track_algorithm;
         int frame_count_method;
-        bool execute_enable;
+        //Control state: written by the control thread, applied by execute() at the next frame boundary
+        boost::atomic<bool> execute_enable;
+        boost::atomic<bool> clear_track_requested;
+        boost::atomic<bool> reinit_track_requested;
+        boost::atomic<int> requested_track_algorithm;
+        boost::atomic<int> requested_frame_count_method;
+        boost::atomic<bool> config_requested;
+        boost::mutex config_mutex;
+        people_detection::PeopleDetectionConfig requested_config;
+        bool extrapolate_enable;
+        double max_extrapolation_time;
+        double tf_timeout;
         tf::TransformListener listener;
-        actionlib::SimpleActionServer<people_detection::ReInitTrackingAction> re_init_track_as_;
-        actionlib::SimpleActionServer<people_detection::PausePeopleDetectionAction> pause_track_as_;
+
+        //High rate track stream: timer runs on its own queue/thread and reads a snapshot of the track list
+        ros::NodeHandle highrate_nh;
+        ros::CallbackQueue highrate_queue;
+        boost::shared_ptr<ros::AsyncSpinner> highrate_spinner;
+        ros::Timer highrate_timer;
+        ros::Publisher people_array_highrate_pub;
+        double track_publish_rate;
+        double interpolation_time;
+        boost::mutex snapshot_mutex;
+        std::vector<person> track_snapshot;
+        unsigned int snapshot_seq;
+        ros::Time snapshot_arrival;
+        unsigned int highrate_last_seq;
+        std::map<int, Eigen::Vector3f> highrate_last_output; //last emitted position per id (camera frame)
+        std::map<int, Eigen::Vector3f> highrate_correction; //offset blended out after a new detection frame
+
+        //Control (actions, services) runs on its own queue/thread so it never waits for a busy detection frame
+        ros::NodeHandle control_nh;
+        ros::CallbackQueue control_queue;
+        boost::shared_ptr<ros::AsyncSpinner> control_spinner;
+        boost::shared_ptr<actionlib::SimpleActionServer<people_detection::ReInitTrackingAction> > re_init_track_as_;
+        boost::shared_ptr<actionlib::SimpleActionServer<people_detection::PausePeopleDetectionAction> > pause_track_as_;
+        boost::shared_ptr<dynamic_reconfigure::Server<people_detection::PeopleDetectionConfig> > reconfigure_server;
         std::string action_name_;
-        // create messages that are used to published feedback/result
-        people_detection::ReInitTrackingActionFeedback re_init_track_feedback_;
-        people_detection::ReInitTrackingActionResult re_init_track_result_;
 
 
         void publishPersonObjectArray(std::vector<person> &tracklist)
         {
             people_detection::PersonObjectArray pubmsg;
-            pubmsg.header.stamp = ros::Time::now();
+            pubmsg.header.stamp = this->cloud_stamp;
             pubmsg.header.frame_id = this->robot_ref_frame;
 
-            //Transform Publish point
-
-            Eigen::Matrix4f tfmat = this->getHomogeneousMatrix(this->camera_frame, this->robot_ref_frame);
+            //Transform Publish point with the tf at capture time
+            Eigen::Matrix4f tfmat = this->getHomogeneousMatrix(this->camera_frame, this->robot_ref_frame, this->cloud_stamp);
+            Eigen::Matrix4f tfmat_now;
+            if(this->extrapolate_enable)
+            {
+                pubmsg.extrapolation_stamp = ros::Time::now();
+                tfmat_now = this->getHomogeneousMatrix(this->camera_frame, this->robot_ref_frame, ros::Time(0));
+            }
             for(int i=0 ;i < tracklist.size();i++)
             {
                 if(tracklist[i].istrack == true)
@@ -83,6 +174,17 @@ class PeopleDetectionRunner{
                     pers.personpoints.y = pubpts(1);
                     pers.personpoints.z = pubpts(2);
 
+                    if(this->extrapolate_enable)
+                    {
+                        Eigen::Vector3f expts = PeopleTracker::extrapolatePosition(tracklist[i],
+                                                        pubmsg.extrapolation_stamp.toSec(), this->max_extrapolation_time);
+                        pubpts << expts(0), expts(1), expts(2), 1.0;
+                        pubpts = tfmat_now*pubpts;
+                    }
+                    pers.extrapolatedpoints.x = pubpts(0);
+                    pers.extrapolatedpoints.y = pubpts(1);
+                    pers.extrapolatedpoints.z = pubpts(2);
+
                     pers.id = tracklist[i].id;
                     pubmsg.persons.push_back(pers);
                 }
@@ -90,12 +192,298 @@ class PeopleDetectionRunner{
             this->people_array_pub.publish(pubmsg);
          }
 
-        //get Homogeneous Transform Matrix (4x4)
-        Eigen::Matrix4f getHomogeneousMatrix(std::string input_frame, std::string des_frame)
+        void publishTrackedPersonArray(std::vector<person> &tracklist)
+        {
+            people_detection::TrackedPersonArray pubmsg;
+            pubmsg.header.stamp = this->cloud_stamp;
+            pubmsg.header.frame_id = this->robot_ref_frame;
+
+            bool keyframe = (!this->track_array_delta) || (this->frames_since_keyframe >= this->delta_keyframe_interval);
+            pubmsg.mode = keyframe ? people_detection::TrackedPersonArray::FULL : people_detection::TrackedPersonArray::DELTA;
+            this->frames_since_keyframe = keyframe ? 0 : this->frames_since_keyframe + 1;
+
+            Eigen::Matrix4f tfmat = this->getHomogeneousMatrix(this->camera_frame, this->robot_ref_frame, this->cloud_stamp);
+            Eigen::Matrix3f rot = tfmat.block<3,3>(0,0);
+            std::map<int, double> current_stamp;
+            std::map<int, bool> current_state;
+            for(int i=0 ;i < tracklist.size();i++)
+            {
+                person &p = tracklist[i];
+                current_stamp[p.id] = p.stamp;
+                current_state[p.id] = p.istrack;
+                if(!keyframe)
+                {
+                    //Skip tracks neither measured nor changed state since the last message
+                    std::map<int, double>::iterator last = this->published_track_stamp.find(p.id);
+                    if((last != this->published_track_stamp.end()) && (last->second == p.stamp)
+                            && (this->published_track_state[p.id] == p.istrack))
+                        continue;
+                }
+
+                people_detection::TrackedPerson pers;
+                Eigen::Vector3f pos = rot*p.points + tfmat.block<3,1>(0,3);
+                Eigen::Vector3f vel = rot*p.velocity;
+                Eigen::Matrix3f cov = rot*p.variance.asDiagonal()*rot.transpose();
+                pers.id = p.id;
+                pers.x = pos(0); pers.y = pos(1); pers.z = pos(2);
+                pers.vx = vel(0); pers.vy = vel(1); pers.vz = vel(2);
+                pers.confidence = p.confidence;
+                pers.framesage = p.framesage;
+                pers.istrack = p.istrack;
+                pers.covariance[0] = cov(0,0); pers.covariance[1] = cov(0,1); pers.covariance[2] = cov(0,2);
+                pers.covariance[3] = cov(1,1); pers.covariance[4] = cov(1,2); pers.covariance[5] = cov(2,2);
+                pubmsg.persons.push_back(pers);
+            }
+
+            if(!keyframe)
+            {
+                for(std::map<int, double>::iterator it = this->published_track_stamp.begin(); it != this->published_track_stamp.end(); ++it)
+                {
+                    if(current_stamp.find(it->first) == current_stamp.end())
+                        pubmsg.removed_ids.push_back(it->first);
+                }
+            }
+            this->published_track_stamp.swap(current_stamp);
+            this->published_track_state.swap(current_state);
+            this->track_array_pub.publish(pubmsg);
+        }
+
+        TrackHistory& getTrackHistory()
+        {
+            if(this->sharded_tracker)
+                return this->sharded_tracker->getTrackHistory();
+            return this->ppl_tracker.getTrackHistory();
+        }
+
+        bool getTrackHistoryCallback(people_detection::GetTrackHistory::Request &req,
+                                     people_detection::GetTrackHistory::Response &res)
+        {
+            if(!this->init_cam_frame)
+                return false;
+            //Samples carry cloud stamps: "the last duration seconds" on the same clock
+            double since = (req.duration > 0.0) ? (this->getHistoryTime().toSec() - req.duration) : 0.0;
+            //History is kept in the camera frame
+            Eigen::Matrix4f tfmat = this->getHomogeneousMatrix(this->camera_frame, this->robot_ref_frame, ros::Time(0));
+            TrackHistory &history = this->getTrackHistory();
+
+            std::vector<int> ids;
+            if(req.query == people_detection::GetTrackHistory::Request::QUERY_TRACK)
+            {
+                ids.push_back(req.id);
+            }
+            else if(req.query == people_detection::GetTrackHistory::Request::QUERY_RADIUS)
+            {
+                Eigen::Vector4f center;
+                center << req.center.x, req.center.y, req.center.z, 1.0;
+                center = tfmat.inverse()*center;
+                history.getTracksWithinRadius(center.head<3>(), (float)req.radius, since, ids);
+            }
+            else
+            {
+                ROS_WARN("Unknown track history query %d", req.query);
+                return false;
+            }
+
+            std::vector<track_sample> samples;
+            for(int i=0; i < ids.size(); i++)
+            {
+                if(!history.getTrack(ids[i], since, samples))
+                    continue;
+                people_detection::TrackHistory track;
+                track.header.stamp = ros::Time::now();
+                track.header.frame_id = this->robot_ref_frame;
+                track.id = ids[i];
+                for(int j=0; j < samples.size(); j++)
+                {
+                    Eigen::Vector4f pts;
+                    pts << samples[j].points(0), samples[j].points(1), samples[j].points(2), 1.0;
+                    pts = tfmat*pts;
+                    geometry_msgs::Point p;
+                    p.x = pts(0); p.y = pts(1); p.z = pts(2);
+                    track.points.push_back(p);
+                    track.stamps.push_back(ros::Time(samples[j].stamp));
+                }
+                res.tracks.push_back(track);
+            }
+            return true;
+        }
+
+        void updateDensityGrid(std::vector<person> &tracklist)
+        {
+            //Confirmed tracks only, as peoplearray
+            Eigen::Matrix4f tfmat = this->getHomogeneousMatrix(this->camera_frame, this->density_grid_frame, this->cloud_stamp);
+            this->density_grid_ids.clear();
+            this->density_grid_positions.clear();
+            for(int i=0 ;i < tracklist.size();i++)
+            {
+                if(tracklist[i].istrack == true)
+                {
+                    Eigen::Vector3f pos = tfmat.block<3,3>(0,0)*tracklist[i].points + tfmat.block<3,1>(0,3);
+                    this->density_grid_ids.push_back(tracklist[i].id);
+                    this->density_grid_positions.push_back(pos.head<2>());
+                }
+            }
+            this->density_grid.update(this->density_grid_ids, this->density_grid_positions, this->cloud_stamp.toSec());
+            boost::mutex::scoped_lock lock(this->density_grid_time_mutex);
+            this->density_grid_stamp = this->cloud_stamp;
+            this->density_grid_processed = ros::Time::now();
+        }
+
+        ros::Time getHistoryTime()
+        {
+            //Sensor time of the last tracked frame plus the time elapsed since, as getDensityGridTime
+            boost::mutex::scoped_lock lock(this->history_time_mutex);
+            if(this->history_stamp.isZero())
+                return ros::Time();
+            return this->history_stamp + (ros::Time::now() - this->history_processed);
+        }
+
+        ros::Time getDensityGridTime()
+        {
+            //Sensor time of the last update plus the time elapsed since it was processed: decay goes on between frames
+            //without mixing the sensor and the ROS clock. Zero before the first update
+            boost::mutex::scoped_lock lock(this->density_grid_time_mutex);
+            if(this->density_grid_stamp.isZero())
+                return ros::Time();
+            return this->density_grid_stamp + (ros::Time::now() - this->density_grid_processed);
+        }
+
+        void densityGridTimerCallback(const ros::TimerEvent &event)
+        {
+            ros::Time stamp = this->getDensityGridTime();
+            if(stamp.isZero())
+                return; //No tracked frame yet
+            people_detection::PeopleDensityGrid pubmsg;
+            pubmsg.header.stamp = stamp;
+            pubmsg.header.frame_id = this->density_grid_frame;
+            pubmsg.resolution = this->density_grid.getResolution();
+            pubmsg.width = this->density_grid.getWidth();
+            pubmsg.height = this->density_grid.getHeight();
+            Eigen::Vector2f origin = this->density_grid.getOrigin();
+            pubmsg.origin.x = origin(0);
+            pubmsg.origin.y = origin(1);
+            pubmsg.decay_time = std::max(0.0f, this->density_grid.getDecayTime());
+
+            std::vector<int> cells, occupancy;
+            this->density_grid.getActiveCells(pubmsg.header.stamp.toSec(), cells, pubmsg.density, occupancy);
+            pubmsg.cells.assign(cells.begin(), cells.end());
+            pubmsg.occupancy.resize(occupancy.size());
+            for(int i=0; i < occupancy.size(); i++)
+                pubmsg.occupancy[i] = std::min(occupancy[i], 255);
+            this->density_grid_pub.publish(pubmsg);
+        }
+
+        bool getPeopleDensityCallback(people_detection::GetPeopleDensity::Request &req,
+                                      people_detection::GetPeopleDensity::Response &res)
+        {
+            Eigen::Vector2f center(req.point.x, req.point.y);
+            res.inside = this->density_grid.getDensity(center, (float)req.radius, this->getDensityGridTime().toSec(),
+                                                       res.density, res.occupancy);
+            return true;
+        }
+
+        void updateTrackSnapshot(std::vector<person> &tracklist)
+        {
+            boost::mutex::scoped_lock lock(this->snapshot_mutex);
+            this->track_snapshot.clear();
+            for(int i=0 ;i < tracklist.size();i++)
+            {
+                if(tracklist[i].istrack == true)
+                    this->track_snapshot.push_back(tracklist[i]);
+            }
+            this->snapshot_seq++;
+            this->snapshot_arrival = ros::Time::now();
+        }
+
+        void highRateTimerCallback(const ros::TimerEvent &event)
+        {
+            std::vector<person> tracklist;
+            bool new_frame;
+            ros::Time arrival;
+            {
+                boost::mutex::scoped_lock lock(this->snapshot_mutex);
+                if(this->snapshot_seq == 0)
+                    return; //No detection frame yet: camera frame is not known
+                tracklist = this->track_snapshot;
+                new_frame = (this->snapshot_seq != this->highrate_last_seq);
+                this->highrate_last_seq = this->snapshot_seq;
+                arrival = this->snapshot_arrival;
+            }
+
+            ros::Time now = ros::Time::now();
+            people_detection::PersonObjectArray pubmsg;
+            pubmsg.header.stamp = now;
+            pubmsg.header.frame_id = this->robot_ref_frame;
+            pubmsg.extrapolation_stamp = now;
+
+            Eigen::Matrix4f tfmat = this->getHomogeneousMatrix(this->camera_frame, this->robot_ref_frame, ros::Time(0));
+            std::map<int, Eigen::Vector3f> last_output;
+            float blend = 0.0f;
+            if(this->interpolation_time > 0.0)
+                blend = 1.0f - (float)((now - arrival).toSec()/this->interpolation_time);
+            for(int i=0 ;i < tracklist.size();i++)
+            {
+                people_detection::PersonObject pers;
+                int id = tracklist[i].id;
+                Eigen::Vector3f pts = PeopleTracker::extrapolatePosition(tracklist[i], now.toSec(), this->max_extrapolation_time);
+
+                if(new_frame)
+                {
+                    //Jump between the old prediction and the new estimate is blended out over interpolation_time
+                    std::map<int, Eigen::Vector3f>::iterator last = this->highrate_last_output.find(id);
+                    if((last != this->highrate_last_output.end()) && (this->interpolation_time > 0.0))
+                        this->highrate_correction[id] = last->second - pts;
+                    else
+                        this->highrate_correction.erase(id);
+                    pers.state = people_detection::PersonObject::MEASURED;
+                }
+                else
+                {
+                    pers.state = people_detection::PersonObject::PREDICTED;
+                }
+
+                std::map<int, Eigen::Vector3f>::iterator corr = this->highrate_correction.find(id);
+                if(corr != this->highrate_correction.end())
+                {
+                    if(blend > 0.0f)
+                    {
+                        pts += corr->second*blend;
+                        pers.state = people_detection::PersonObject::INTERPOLATED;
+                    }
+                    else
+                        this->highrate_correction.erase(corr);
+                }
+                last_output[id] = pts;
+
+                Eigen::Vector4f pubpts;
+                pubpts << pts(0), pts(1), pts(2), 1.0;
+                pubpts = tfmat*pubpts;
+                pers.personpoints.x = pubpts(0);
+                pers.personpoints.y = pubpts(1);
+                pers.personpoints.z = pubpts(2);
+                pers.extrapolatedpoints = pers.personpoints;
+                pers.id = id;
+                pubmsg.persons.push_back(pers);
+            }
+            this->highrate_last_output.swap(last_output);
+            this->people_array_highrate_pub.publish(pubmsg);
+        }
+
+        //get Homogeneous Transform Matrix (4x4) at stamp, fall back to the latest one if not available in time
+        Eigen::Matrix4f getHomogeneousMatrix(std::string input_frame, std::string des_frame, ros::Time stamp)
         {
             tf::StampedTransform transform;
             try{
-                this->listener.lookupTransform(des_frame, input_frame, ros::Time(0), transform);
+                if(!stamp.isZero() && this->listener.waitForTransform(des_frame, input_frame, stamp, ros::Duration(this->tf_timeout)))
+                {
+                    this->listener.lookupTransform(des_frame, input_frame, stamp, transform);
+                }
+                else
+                {
+                    if(!stamp.isZero())
+                        ROS_WARN_THROTTLE(1.0, "No tf %s -> %s at cloud stamp: Using latest", input_frame.c_str(), des_frame.c_str());
+                    this->listener.lookupTransform(des_frame, input_frame, ros::Time(0), transform);
+                }
             }
             catch (tf::TransformException ex){
                 ROS_ERROR("%s",ex.what());
@@ -110,30 +498,48 @@ class PeopleDetectionRunner{
         PeopleDetectionRunner(std::string name):
                 nh("~"),
                 cloud_obj(new PointCloudT),
-                re_init_track_as_(nh, name, boost::bind(&PeopleDetectionRunner::executeReInitTrackActionCallback, this, _1), false),
                 action_name_(name),
-                pause_track_as_(nh, name, boost::bind(&PeopleDetectionRunner::executePauseTrackActionCallback, this, _1), false)
+                control_nh("~"),
+                highrate_nh("~")
                 {
+                    this->startup_time = ros::WallTime::now();
+                    this->first_detection_done = false;
                     this->init_cam_frame = false;
                     this->new_cloud_available_flag = false;
                     this->execute_enable = true;
+                    this->clear_track_requested = false;
+                    this->reinit_track_requested = false;
+                    this->requested_track_algorithm = MULTI_NEAREST_NEIGHBOR_TRACKER;
+                    this->requested_frame_count_method = UPDATE_WITH_FRAME_COUNT;
+                    this->config_requested = false;
+                    this->snapshot_seq = 0;
+                    this->highrate_last_seq = 0;
                     double track_distance;
                     double min_confidence;
                     double min_height;
                     double max_height;
                     double detect_range;
                     double head_min_dist;
+                    double voxel_size;
                     std::string ref_file_path;
                     std::string string_intrinsic;
                     //Init ROS NODE
                     this->cloub_sub = nh.subscribe(DEFAULT_CLOUD_TOPIC, 1, &PeopleDetectionRunner::cloudCallback, this);
                     this->people_array_pub = nh.advertise<people_detection::PersonObjectArray>("peoplearray", 1);
+                    this->track_array_pub = nh.advertise<people_detection::TrackedPersonArray>("trackarray", 1);
+                    this->frames_since_keyframe = 0;
                     //this->service = nh.advertiseService("/clearpeopletracker", &PeopleDetectionRunner::cleartrackCallback, this);
 
                     //INIT ROS PARAM
                     nh.param<std::string>( "ref_svm_path", ref_file_path, "/trainedLinearSVMForPeopleDetectionWithHOG.yaml");
                     std::string svm_filename = ros::package::getPath("people_detection") + ref_file_path;
                     ROS_INFO( "ref_svm_path: %s", ref_file_path.c_str() );
+                    std::string ref_cache_path;
+                    nh.param<std::string>( "ref_svm_cache_path", ref_cache_path, "/trainedLinearSVMForPeopleDetectionWithHOG.bin");
+                    std::string svm_cache_filename;
+                    if(!ref_cache_path.empty())
+                        svm_cache_filename = ros::package::getPath("people_detection") + ref_cache_path;
+                    ROS_INFO( "ref_svm_cache_path: %s", ref_cache_path.c_str() );
                     nh.param<std::string>( "rgb_intrinsic", string_intrinsic, "525 0.0 319.5 0.0 525 239.5 0.0 0.0 1.0");
                     //Default = Kinect RGB Intrinsic Params
                     Eigen::Matrix3f rgb_intrinsic = PeopleDetector::IntrinsicParamtoMatrix3f(string_intrinsic);
@@ -142,6 +548,23 @@ class PeopleDetectionRunner{
                     nh.param<std::string>( "robot_base_frame", this->robot_ref_frame, DEFAULT_ROBOT_LINK);
                     ROS_INFO( "robot_base_frame: %s", this->robot_ref_frame.c_str());
 
+                    std::string record_detections_path;
+                    nh.param<std::string>( "record_detections_path", record_detections_path, "");
+                    ROS_INFO( "record_detections_path: %s", record_detections_path.c_str());
+                    if(!record_detections_path.empty())
+                    {
+                        if(!this->detection_log.open(record_detections_path))
+                            ROS_ERROR("Cannot open detection log %s (or not a detection log version %d): Recording disabled",
+                                      record_detections_path.c_str(), DETECTION_LOG_VERSION);
+                        else if(this->detection_log.getDroppedBytes() > 0)
+                            ROS_WARN("Detection log %s ended in an incomplete frame: %lu bytes dropped", record_detections_path.c_str(),
+                                     (unsigned long)this->detection_log.getDroppedBytes());
+                    }
+
+                    //Known camera frame: no need to wait for the first cloud to latch it
+                    nh.param<std::string>( "camera_frame", this->camera_frame, "");
+                    ROS_INFO( "camera_frame: %s", this->camera_frame.c_str());
+
                     nh.param( "detect_range", detect_range, DEFAULT_DETECT_RANGE );
                     ROS_INFO( "detect_range: %lf", detect_range );
 
@@ -157,6 +580,25 @@ class PeopleDetectionRunner{
                     nh.param( "head_min_distance", head_min_dist, DEFAULT_HEAD_MINIMUM_DISTANCE );
                     ROS_INFO( "head_min_distance: %lf", head_min_dist);
 
+                    nh.param( "voxel_size", voxel_size, DEFAULT_VOXEL_SIZE );
+                    ROS_INFO( "voxel_size: %lf", voxel_size);
+
+                    nh.param( "compact_pipeline", this->compact_pipeline, true);
+                    ROS_INFO( "compact_pipeline: %d", this->compact_pipeline);
+
+                    int downsample_threads;
+                    nh.param( "downsample_threads", downsample_threads, 0);
+                    ROS_INFO( "downsample_threads: %d", downsample_threads);
+
+                    bool height_map_candidates;
+                    double height_map_cell_size;
+                    nh.param( "height_map_candidates", height_map_candidates, false);
+                    ROS_INFO( "height_map_candidates: %d", height_map_candidates);
+                    nh.param( "height_map_cell_size", height_map_cell_size, DEFAULT_HEIGHT_MAP_CELL_SIZE);
+                    ROS_INFO( "height_map_cell_size: %lf", height_map_cell_size);
+                    if(height_map_candidates && !this->compact_pipeline)
+                        ROS_WARN("height_map_candidates needs compact_pipeline: using Euclidean clustering");
+
                     nh.param( "ui", this->ui_enable, true);
                     ROS_INFO( "ui_enable: %d", this->ui_enable);
 
@@ -178,35 +620,293 @@ class PeopleDetectionRunner{
                     nh.param( "frame_count_method",this->frame_count_method, UPDATE_WITH_FRAME_COUNT);
                     ROS_INFO( "frame_count_method: %s", frame_count_method_name[this->frame_count_method].c_str());
 
+                    nh.param( "extrapolate_to_publish_time", this->extrapolate_enable, false);
+                    ROS_INFO( "extrapolate_to_publish_time: %d", this->extrapolate_enable);
+
+                    nh.param( "max_extrapolation_time", this->max_extrapolation_time, DEFAULT_MAX_EXTRAPOLATION_TIME);
+                    ROS_INFO( "max_extrapolation_time: %lf", this->max_extrapolation_time);
+
+                    nh.param( "tf_timeout", this->tf_timeout, DEFAULT_TF_TIMEOUT);
+                    ROS_INFO( "tf_timeout: %lf", this->tf_timeout);
+
+                    nh.param( "track_publish_rate", this->track_publish_rate, DEFAULT_TRACK_PUBLISH_RATE);
+                    ROS_INFO( "track_publish_rate: %lf", this->track_publish_rate);
+
+                    nh.param( "interpolation_time", this->interpolation_time, DEFAULT_INTERPOLATION_TIME);
+                    ROS_INFO( "interpolation_time: %lf", this->interpolation_time);
+
+                    nh.param( "track_array_delta", this->track_array_delta, false);
+                    ROS_INFO( "track_array_delta: %d", this->track_array_delta);
+
+                    nh.param( "delta_keyframe_interval", this->delta_keyframe_interval, DEFAULT_DELTA_KEYFRAME_INTERVAL);
+                    ROS_INFO( "delta_keyframe_interval: %d", this->delta_keyframe_interval);
+
+                    int history_max_tracks;
+                    double history_duration;
+                    double history_frame_rate;
+                    nh.param( "history_max_tracks", history_max_tracks, DEFAULT_HISTORY_MAX_TRACKS);
+                    ROS_INFO( "history_max_tracks: %d", history_max_tracks);
+
+                    nh.param( "history_duration", history_duration, DEFAULT_HISTORY_DURATION);
+                    ROS_INFO( "history_duration: %lf", history_duration);
+
+                    nh.param( "history_frame_rate", history_frame_rate, DEFAULT_HISTORY_FRAME_RATE);
+                    if(history_frame_rate <= 0.0)
+                    {
+                        ROS_WARN("history_frame_rate must be positive: Use %lf", DEFAULT_HISTORY_FRAME_RATE);
+                        history_frame_rate = DEFAULT_HISTORY_FRAME_RATE;
+                    }
+                    ROS_INFO( "history_frame_rate: %lf", history_frame_rate);
+                    int history_samples = (int)ceil(history_duration*history_frame_rate);
+
+                    bool sharded_tracking;
+                    double shard_tile_size;
+                    int shard_threads;
+                    nh.param( "sharded_tracking", sharded_tracking, false);
+                    ROS_INFO( "sharded_tracking: %d", sharded_tracking);
+
+                    nh.param( "shard_tile_size", shard_tile_size, DEFAULT_SHARD_TILE_SIZE);
+                    ROS_INFO( "shard_tile_size: %lf", shard_tile_size);
+
+                    nh.param( "shard_threads", shard_threads, 0);
+                    ROS_INFO( "shard_threads: %d", shard_threads);
+
+                    double density_grid_resolution;
+                    int density_grid_width;
+                    int density_grid_height;
+                    double density_grid_origin_x;
+                    double density_grid_origin_y;
+                    double density_grid_decay_time;
+                    nh.param( "density_grid_publish_rate", this->density_grid_publish_rate, DEFAULT_DENSITY_GRID_PUBLISH_RATE);
+                    ROS_INFO( "density_grid_publish_rate: %lf", this->density_grid_publish_rate);
+
+                    nh.param<std::string>( "density_grid_frame", this->density_grid_frame, "");
+                    if(this->density_grid_frame.empty())
+                        this->density_grid_frame = this->robot_ref_frame;
+                    ROS_INFO( "density_grid_frame: %s", this->density_grid_frame.c_str());
+
+                    nh.param( "density_grid_resolution", density_grid_resolution, DEFAULT_DENSITY_GRID_RESOLUTION);
+                    ROS_INFO( "density_grid_resolution: %lf", density_grid_resolution);
+
+                    nh.param( "density_grid_width", density_grid_width, DEFAULT_DENSITY_GRID_WIDTH);
+                    ROS_INFO( "density_grid_width: %d", density_grid_width);
+
+                    nh.param( "density_grid_height", density_grid_height, DEFAULT_DENSITY_GRID_HEIGHT);
+                    ROS_INFO( "density_grid_height: %d", density_grid_height);
+
+                    //Default: grid centered on the frame origin
+                    nh.param( "density_grid_origin_x", density_grid_origin_x, -0.5*density_grid_width*density_grid_resolution);
+                    ROS_INFO( "density_grid_origin_x: %lf", density_grid_origin_x);
+
+                    nh.param( "density_grid_origin_y", density_grid_origin_y, -0.5*density_grid_height*density_grid_resolution);
+                    ROS_INFO( "density_grid_origin_y: %lf", density_grid_origin_y);
+
+                    nh.param( "density_grid_decay_time", density_grid_decay_time, DEFAULT_DENSITY_GRID_DECAY_TIME);
+                    ROS_INFO( "density_grid_decay_time: %lf", density_grid_decay_time);
+
                     //Init People Detector
                     this->ppl_detector.initPeopleDetector(svm_filename, rgb_intrinsic, min_height, max_height,
-                                                                                         min_confidence, head_min_dist, detect_range);
+                                                                                         min_confidence, head_min_dist, detect_range, voxel_size,
+                                                                                         svm_cache_filename);
+                    //tf buffered from now on: the first frames already have the ground plane
+                    this->ppl_detector.initTransformListener();
+                    this->ppl_detector.setDownsampleThreads(downsample_threads);
+                    this->ppl_detector.setHeightMapCandidates(height_map_candidates, (float)height_map_cell_size);
+                    if(!this->camera_frame.empty())
+                    {
+                        this->ppl_detector.setRobotFrame(this->camera_frame,this->robot_ref_frame);
+                        this->init_cam_frame = true;
+                    }
+
+                    //Pre-warm frame buffers: first frames do not grow them
+                    if(this->compact_pipeline)
+                        this->compact_cloud.reserve(DEFAULT_CLOUD_WIDTH, DEFAULT_CLOUD_HEIGHT);
+                    if(!this->compact_pipeline || this->ui_enable)
+                        this->cloud_obj->points.reserve(DEFAULT_CLOUD_WIDTH*DEFAULT_CLOUD_HEIGHT);
+                    this->center_buffer.reserve(DEFAULT_MAX_PEOPLE);
+                    this->confidence_buffer.reserve(DEFAULT_MAX_PEOPLE);
 
                     this->ppl_tracker.setTrackThreshold(track_distance);
                     this->ppl_tracker.setListUpdateConstraints(this->get_in_track, this->get_in_check, this->out_of_track);
-                    //Init PCL Viewer
-                    if(this->ui_enable)
+                    //One sample per processed frame: history_duration at history_frame_rate
+                    this->ppl_tracker.setHistoryCapacity(history_max_tracks, history_samples);
+                    if(sharded_tracking)
                     {
-                        viewer = boost::shared_ptr<pcl::visualization::PCLVisualizer>(new pcl::visualization::PCLVisualizer ("PCL Viewer"));
-                        viewer->setCameraPosition(0,0,-2,0,-1,0,0);
+                        this->sharded_tracker.reset(new ShardedPeopleTracker(shard_threads));
+                        this->sharded_tracker->setTileSize(shard_tile_size);
+                        this->sharded_tracker->setTrackThreshold(track_distance);
+                        this->sharded_tracker->setListUpdateConstraints(this->get_in_track, this->get_in_check, this->out_of_track);
+                        this->sharded_tracker->setHistoryCapacity(history_max_tracks, history_samples);
+                        //The full size pool is only needed by the tracker in use
+                        this->ppl_tracker.setHistoryCapacity(1, 1);
+                        ROS_INFO( "Sharded tracking on %d threads", this->sharded_tracker->getThreadCount());
                     }
 
-                    ROS_INFO("-------Complete Initialization--------");
+                    this->density_grid.setGeometry((float)density_grid_resolution, density_grid_width, density_grid_height,
+                                                   Eigen::Vector2f(density_grid_origin_x, density_grid_origin_y));
+                    this->density_grid.setDecayTime((float)density_grid_decay_time);
+
+                    //Init Control Interface
+                    this->control_nh.setCallbackQueue(&this->control_queue);
+                    this->track_history_srv = this->control_nh.advertiseService("get_track_history", &PeopleDetectionRunner::getTrackHistoryCallback, this);
+                    if(this->density_grid_publish_rate > 0.0)
+                    {
+                        this->density_grid_pub = this->control_nh.advertise<people_detection::PeopleDensityGrid>("densitygrid", 1);
+                        this->density_grid_timer = this->control_nh.createTimer(ros::Duration(1.0/this->density_grid_publish_rate),
+                                                                                &PeopleDetectionRunner::densityGridTimerCallback, this);
+                        this->people_density_srv = this->control_nh.advertiseService("get_people_density", &PeopleDetectionRunner::getPeopleDensityCallback, this);
+                    }
+                    this->re_init_track_as_.reset(new actionlib::SimpleActionServer<people_detection::ReInitTrackingAction>(this->control_nh, "reinit_tracking",
+                                                    boost::bind(&PeopleDetectionRunner::executeReInitTrackActionCallback, this, _1), false));
+                    this->pause_track_as_.reset(new actionlib::SimpleActionServer<people_detection::PausePeopleDetectionAction>(this->control_nh, "pause_detection",
+                                                    boost::bind(&PeopleDetectionRunner::executePauseTrackActionCallback, this, _1), false));
+                    this->re_init_track_as_->start();
+                    this->pause_track_as_->start();
+                    this->requested_config.detect_range = detect_range;
+                    this->requested_config.min_confidence = min_confidence;
+                    this->requested_config.min_height = min_height;
+                    this->requested_config.max_height = max_height;
+                    this->requested_config.head_min_distance = head_min_dist;
+                    this->requested_config.voxel_size = voxel_size;
+                    this->requested_config.track_distance = track_distance;
+                    this->requested_config.get_in_condition = this->get_in_track;
+                    this->requested_config.get_in_check = this->get_in_check;
+                    this->requested_config.out_track_condition = this->out_of_track;
+                    this->reconfigure_server.reset(new dynamic_reconfigure::Server<people_detection::PeopleDetectionConfig>(this->control_nh));
+                    this->reconfigure_server->setCallback(boost::bind(&PeopleDetectionRunner::reconfigureCallback, this, _1, _2));
+                    this->control_spinner.reset(new ros::AsyncSpinner(1, &this->control_queue));
+                    this->control_spinner->start();
+
+                    //Init High Rate Track Stream
+                    if(this->track_publish_rate > 0.0)
+                    {
+                        this->highrate_nh.setCallbackQueue(&this->highrate_queue);
+                        this->people_array_highrate_pub = this->highrate_nh.advertise<people_detection::PersonObjectArray>("peoplearray_highrate", 1);
+                        this->highrate_timer = this->highrate_nh.createTimer(ros::Duration(1.0/this->track_publish_rate),
+                                                                             &PeopleDetectionRunner::highRateTimerCallback, this);
+                        this->highrate_spinner.reset(new ros::AsyncSpinner(1, &this->highrate_queue));
+                        this->highrate_spinner->start();
+                    }
+
+                    ROS_INFO("-------Complete Initialization in %.3lf s--------", (ros::WallTime::now() - this->startup_time).toSec());
 
                 };
 
+        void applyControlRequests()
+        {
+            if(this->reinit_track_requested.exchange(false))
+            {
+                this->track_algorithm = this->requested_track_algorithm;
+                this->frame_count_method = this->requested_frame_count_method;
+                ROS_INFO( "Re-init tracking: %s, %s", algorithm_name[this->track_algorithm].c_str(),
+                          frame_count_method_name[this->frame_count_method].c_str());
+            }
+            if(this->config_requested.exchange(false))
+            {
+                people_detection::PeopleDetectionConfig config;
+                {
+                    boost::mutex::scoped_lock lock(this->config_mutex);
+                    config = this->requested_config;
+                }
+                this->ppl_detector.setDetectorParameters(config.min_height, config.max_height, config.min_confidence,
+                                                         config.head_min_distance, config.detect_range, config.voxel_size);
+                this->get_in_track = config.get_in_condition;
+                this->get_in_check = config.get_in_check;
+                this->out_of_track = config.out_track_condition;
+                this->ppl_tracker.setTrackThreshold(config.track_distance);
+                this->ppl_tracker.setListUpdateConstraints(this->get_in_track, this->get_in_check, this->out_of_track);
+                if(this->sharded_tracker)
+                {
+                    this->sharded_tracker->setTrackThreshold(config.track_distance);
+                    this->sharded_tracker->setListUpdateConstraints(this->get_in_track, this->get_in_check, this->out_of_track);
+                }
+                ROS_INFO( "Active config: detect_range %lf, min_confidence %lf, height [%lf, %lf], head_min_distance %lf, voxel_size %lf",
+                          config.detect_range, config.min_confidence, config.min_height, config.max_height,
+                          config.head_min_distance, config.voxel_size);
+                ROS_INFO( "Active config: track_distance %lf, get_in_condition %d, get_in_check %d, out_track_condition %d",
+                          config.track_distance, config.get_in_condition, config.get_in_check, config.out_track_condition);
+            }
+            if(this->clear_track_requested.exchange(false))
+            {
+                this->world_track_list.clear();
+                this->getTrackHistory().clear();
+                if(this->density_grid_publish_rate > 0.0)
+                {
+                    //At the last update: the next frame has a later cloud stamp
+                    boost::mutex::scoped_lock lock(this->density_grid_time_mutex);
+                    this->density_grid.removeAllTracks(this->density_grid_stamp.toSec());
+                }
+            }
+        }
+
         void execute()
         {
+            this->applyControlRequests();
             if((this->new_cloud_available_flag) && (this->init_cam_frame) && (this->execute_enable))
             {
-                std::vector<Eigen::Vector3f> tmp_center_list;
-                this->ppl_detector.getPeopleCenter(this->cloud_obj,tmp_center_list);
+                this->center_buffer.clear();
+                this->confidence_buffer.clear();
+                bool detected;
+                if(this->compact_pipeline)
+                    detected = this->ppl_detector.getPeopleCenter(this->compact_cloud,this->center_buffer,this->confidence_buffer);
+                else
+                    detected = this->ppl_detector.getPeopleCenter(this->cloud_obj,this->center_buffer,this->confidence_buffer);
+                if(!detected)
+                {
+                    //No ground plane: the tracks are not given a frame without detections
+                    this->new_cloud_available_flag = false;
+                    return;
+                }
                 std::cout << "finish Detecting*********" << std::endl;
-                this->ppl_tracker.trackPeople(this->world_track_list, tmp_center_list, this->track_algorithm, this->frame_count_method);
+                if(this->detection_log.isOpen())
+                    this->detection_log.write(this->cloud_stamp.toSec(), this->center_buffer, this->confidence_buffer);
+                if(this->sharded_tracker)
+                {
+                    this->sharded_tracker->setFrameStamp(this->cloud_stamp.toSec());
+                    this->sharded_tracker->setFrameConfidences(this->confidence_buffer);
+                    this->sharded_tracker->trackPeople(this->world_track_list, this->center_buffer, this->track_algorithm, this->frame_count_method);
+                }
+                else
+                {
+                    this->ppl_tracker.setFrameStamp(this->cloud_stamp.toSec());
+                    this->ppl_tracker.setFrameConfidences(this->confidence_buffer);
+                    this->ppl_tracker.trackPeople(this->world_track_list, this->center_buffer, this->track_algorithm, this->frame_count_method);
+                }
+                {
+                    boost::mutex::scoped_lock lock(this->history_time_mutex);
+                    this->history_stamp = this->cloud_stamp;
+                    this->history_processed = ros::Time::now();
+                }
                 std::cout << "finish Tracking**********" << std::endl;
+
+                for(int i=0; i< this->world_track_list.size();i++)
+                {
+                    if(this->world_track_list[i].istrack)
+                        std::cout << "Tracked ID : " << this->world_track_list[i].id << std::endl;
+                }
+
+                this->publishPersonObjectArray(this->world_track_list);
+                this->publishTrackedPersonArray(this->world_track_list);
+                if(this->track_publish_rate > 0.0)
+                    this->updateTrackSnapshot(this->world_track_list);
+                if(this->density_grid_publish_rate > 0.0)
+                    this->updateDensityGrid(this->world_track_list);
+
+                if(!this->first_detection_done)
+                {
+                    this->first_detection_done = true;
+                    ROS_INFO("Time to first detection: %.3lf s (first cloud after %.3lf s)",
+                             (ros::WallTime::now() - this->startup_time).toSec(), (this->first_cloud_time - this->startup_time).toSec());
+                }
+
+                //UI after publishing: drawing (and creating the viewer) does not delay the output
                 if(this->ui_enable)
                 {
-                    
+                    if(!viewer)
+                    {
+                        viewer = boost::shared_ptr<pcl::visualization::PCLVisualizer>(new pcl::visualization::PCLVisualizer ("PCL Viewer"));
+                        viewer->setCameraPosition(0,0,-2,0,-1,0,0);
+                    }
                     this->ppl_detector.addNewCloudToViewer(this->cloud_obj,viewer);
                     std::cout << "add New Cloud to Viewer**********" << std::endl;
                     this->ppl_detector.drawPeopleDetectBox(viewer);
@@ -222,14 +922,6 @@ class PeopleDetectionRunner{
                     }
 
                 }
-
-                for(int i=0; i< this->world_track_list.size();i++)
-                {
-                    if(this->world_track_list[i].istrack)
-                        std::cout << "Tracked ID : " << this->world_track_list[i].id << std::endl;
-                }
-
-                this->publishPersonObjectArray(this->world_track_list);
                 this->new_cloud_available_flag = false;
                 std::cout << "----------------------------------------------" << std::endl;
             }
@@ -241,36 +933,83 @@ class PeopleDetectionRunner{
             {
                 this->camera_frame = cloud_in->header.frame_id.c_str();
                 this->ppl_detector.setRobotFrame(this->camera_frame,this->robot_ref_frame);
-                this->init_cam_frame = true;
+                this->init_cam_frame = true; //camera_frame is read-only for other threads from here
                 ROS_INFO("Camera frame: %s", this->camera_frame.c_str());
                 ROS_INFO("-----DONE: INIT ROBOT FRAME----");
             }
+            else if(cloud_in->header.frame_id != this->camera_frame)
+            {
+                ROS_WARN_THROTTLE(5.0, "Cloud frame %s differs from camera_frame %s", cloud_in->header.frame_id.c_str(), this->camera_frame.c_str());
+            }
+            if(this->first_cloud_time.isZero())
+                this->first_cloud_time = ros::WallTime::now();
 
             if(this->new_cloud_available_flag)
                 return; //Flush Cloud data while still processing
 
-            pcl::fromROSMsg (*cloud_in, *cloud_obj);
+            if(this->compact_pipeline)
+            {
+                //Converted and cropped in one pass, the full cloud only for the viewer
+                if(!this->compact_cloud.fromROSMsg(*cloud_in, this->ppl_detector.getCropRange()))
+                {
+                    ROS_WARN_THROTTLE(5.0, "Cloud without FLOAT32 x, y, z fields or with a malformed layout: Skipped");
+                    return;
+                }
+                if(this->ui_enable)
+                    pcl::fromROSMsg (*cloud_in, *cloud_obj);
+            }
+            else
+            {
+                pcl::fromROSMsg (*cloud_in, *cloud_obj);
+            }
+            this->cloud_stamp = cloud_in->header.stamp;
             this->new_cloud_available_flag = true;
         }
 
+        //Control callbacks only latch requests: the detection thread applies them before its next frame
         void executeReInitTrackActionCallback(const people_detection::ReInitTrackingGoalConstPtr &goal)
         {
-            this->execute_enable = false;
-            this->track_algorithm = goal->algorithm;
-            this->frame_count_method = goal->update_method;
-            this->world_track_list.clear();
-            people_detection::ReInitTrackingResultPtr result;
-            result->status = true;
-            re_init_track_as_.setSucceeded(*result);
-            this->execute_enable = true;
+            people_detection::ReInitTrackingResult result;
+            if((goal->algorithm < SINGLE_NEAREST_NEIGHBOR_TRACKER) || (goal->algorithm > KALMAN_TRACKER) ||
+               (goal->update_method < UPDATE_NORMAL) || (goal->update_method > UPDATE_WITH_FRAME_COUNT))
+            {
+                ROS_WARN("Re-init tracking: invalid algorithm %d or update method %d", goal->algorithm, goal->update_method);
+                result.status = false;
+                this->re_init_track_as_->setAborted(result);
+                return;
+            }
+            this->requested_track_algorithm = goal->algorithm;
+            this->requested_frame_count_method = goal->update_method;
+            this->reinit_track_requested = true;
+            this->clear_track_requested = true;
+            result.status = true;
+            this->re_init_track_as_->setSucceeded(result);
+        }
+
+        void reconfigureCallback(people_detection::PeopleDetectionConfig &config, uint32_t level)
+        {
+            //Ranges are enforced by the cfg, cross-parameter checks here. Rejected: report the last accepted config back
+            boost::mutex::scoped_lock lock(this->config_mutex);
+            if(config.min_height >= config.max_height)
+            {
+                ROS_WARN("Reconfigure rejected: min_height %lf must be below max_height %lf", config.min_height, config.max_height);
+                config = this->requested_config;
+                return;
+            }
+            this->requested_config = config;
+            this->config_requested = true;
         }
 
         void executePauseTrackActionCallback(const people_detection::PausePeopleDetectionGoalConstPtr &goal)
         {
-            this->execute_enable = ~(this->execute_enable);
-            if(this->execute_enable)
-                this->world_track_list.clear();
-            pause_track_as_.setSucceeded();
+            //Toggle: resuming starts from an empty track list
+            bool enable = !this->execute_enable.load();
+            if(enable)
+                this->clear_track_requested = true;
+            this->execute_enable = enable;
+            people_detection::PausePeopleDetectionResult result;
+            result.status = enable;
+            this->pause_track_as_->setSucceeded(result);
         }
 
 
@@ -0,0 +1,41 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// Offline converter: YAML SVM model (PersonClassifier::loadSVMFromFile) -> binary SVMModelCache file
+//
+
+#include <iostream>
+#include <SVMModelCache.h>
+
+
+int main( int argc, char **argv )
+{
+    if(argc < 3)
+    {
+        std::cout << "Usage: svm_model_converter <svm_model.yaml> <svm_model.bin>" << std::endl;
+        return 1;
+    }
+    pcl::people::PersonClassifier<pcl::RGB> classifier;
+    if(!classifier.loadSVMFromFile(argv[1]))
+    {
+        std::cout << "Cannot load SVM model: " << argv[1] << std::endl;
+        return 1;
+    }
+    if(!SVMModelCache::save(argv[2], classifier, argv[1]))
+    {
+        std::cout << "Cannot write SVM cache: " << argv[2] << std::endl;
+        return 1;
+    }
+
+    //Read back to check the cache gives the same model
+    pcl::people::PersonClassifier<pcl::RGB> check;
+    if((SVMModelCache::load(argv[2], check, argv[1]) != SVM_MODEL_CACHE_OK) || (check.getSVMWeights() != classifier.getSVMWeights()) ||
+       (check.getSVMOffset() != classifier.getSVMOffset()))
+    {
+        std::cout << "SVM cache verification failed: " << argv[2] << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << argv[2] << ": " << classifier.getSVMWeights().size() << " weights, window "
+              << classifier.getWindowWidth() << "x" << classifier.getWindowHeight() << std::endl;
+    return 0;
+}
@@ -0,0 +1,247 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// Synthetic crowd clouds: write PCD sequences with ground truth, or stream them in-process through
+// PeopleDetector and PeopleTracker for timing and scaling curves.
+//
+
+#include <cstdio>
+#include <pcl/io/pcd_io.h>
+#include <PeopleDetector.h>
+#include <PeopleTracker.h>
+#include <DetectionLog.h>
+#include <SyntheticCrowd.h>
+
+
+#define DEFAULT_CROWD_X_RANGE 2.5
+#define DEFAULT_CROWD_Z_MIN 1.2
+#define DEFAULT_CROWD_Z_MAX 6.0
+
+typedef struct{
+    int people;
+    double generate_ms;
+    double detect_ms;
+    double track_ms;
+    double detections; //per frame
+    double confirmed_tracks; //per frame
+}stream_stats;
+
+void printUsage(const char *prog)
+{
+    std::cout << "Usage: " << prog << " [options]" << std::endl
+              << "  --people N            people in the scene (default 5)" << std::endl
+              << "  --frames N            frames per run (default 100)" << std::endl
+              << "  --rate F              frame rate of the stamps in Hz (default 10)" << std::endl
+              << "  --clutter N           boxes on the floor (default 3)" << std::endl
+              << "  --seed S              scene seed (default 1)" << std::endl
+              << "  --noise F             depth noise coefficient, stddev = F*z^2 (default 0.0015)" << std::endl
+              << "  --camera-height F     camera height above the floor (default " << DEFAULT_SYNTHETIC_CAMERA_HEIGHT << ")" << std::endl
+              << "  --rgb-intrinsic STR   9 values row major (default Kinect)" << std::endl
+              << " Output PCD sequence:" << std::endl
+              << "  --pcd-dir DIR         DIR/frame_NNNNN.pcd, DIR/ground_truth.txt (frame gt_id x y z), DIR/ground_coeffs.txt" << std::endl
+              << " Stream through the detector and tracker in-process:" << std::endl
+              << "  --stream              run PeopleDetector + PeopleTracker on every frame" << std::endl
+              << "  --svm FILE            SVM model (default: package trainedLinearSVMForPeopleDetectionWithHOG.yaml)" << std::endl
+              << "  --min-confidence F    detector threshold (default " << DEFAULT_MIN_CONFIDENCE << ")" << std::endl
+              << "  --compact             compact pipeline (CompactCloud, as the node default), detect_ms includes the conversion" << std::endl
+              << "  --record FILE         append the detections to a DetectionLog (tracker_replay, tracker_sweep)" << std::endl
+              << "  --scaling-max N       scaling curve from --people to N people" << std::endl
+              << "  --scaling-step N      people step of the scaling curve (default 10)" << std::endl
+              << "  --output FILE         scaling CSV (default stdout)" << std::endl;
+}
+
+stream_stats runStream(SyntheticCrowd &crowd, PeopleDetector *detector, int n_people, int frames, double rate, bool compact,
+                       DetectionLogWriter *log)
+{
+    stream_stats stats;
+    stats.people = n_people;
+    stats.generate_ms = stats.detect_ms = stats.track_ms = 0.0;
+    stats.detections = stats.confirmed_tracks = 0.0;
+
+    PeopleTracker tracker;
+    tracker.setVerbose(false);
+    tracker.setListUpdateConstraints(DEFAULT_GET_IN_TRACK_CONDITION, DEFAULT_GET_IN_TRACK_CHECK_FRAME, DEFAULT_OUT_OF_TRACK_CONDITION);
+    tracker.setTrackThreshold(DEFAULT_TRACK_DISTANCE);
+
+    PointCloudT::Ptr cloud(new PointCloudT);
+    CompactCloud compact_cloud;
+    std::vector<synthetic_ground_truth> ground_truth;
+    std::vector<person> track_list;
+    std::vector<Eigen::Vector3f> centers;
+    std::vector<float> confidences;
+    Eigen::VectorXf ground_coeffs = crowd.getGroundCoeffs();
+    for(int f=0; f < frames; f++)
+    {
+        double stamp = f/rate;
+        ros::WallTime t0 = ros::WallTime::now();
+        crowd.generate(stamp, *cloud, ground_truth);
+        cloud->header.stamp = (uint64_t)(stamp*1e6);
+        ros::WallTime t1 = ros::WallTime::now();
+        centers.clear();
+        confidences.clear();
+        if(compact)
+        {
+            compact_cloud.fromPCL(*cloud, detector->getCropRange());
+            detector->getPeopleCenter(compact_cloud, ground_coeffs, centers, confidences);
+        }
+        else
+        {
+            detector->getPeopleCenter(cloud, ground_coeffs, centers, confidences);
+        }
+        ros::WallTime t2 = ros::WallTime::now();
+        tracker.setFrameStamp(stamp);
+        tracker.setFrameConfidences(confidences);
+        tracker.trackPeople(track_list, centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+        ros::WallTime t3 = ros::WallTime::now();
+
+        stats.generate_ms += (t1 - t0).toSec()*1e3;
+        stats.detect_ms += (t2 - t1).toSec()*1e3;
+        stats.track_ms += (t3 - t2).toSec()*1e3;
+        stats.detections += centers.size();
+        for(int i=0; i < track_list.size(); i++)
+            stats.confirmed_tracks += track_list[i].istrack ? 1 : 0;
+        if(log != NULL)
+            log->write(stamp, centers, confidences);
+    }
+    if(frames > 0)
+    {
+        stats.generate_ms /= frames;
+        stats.detect_ms /= frames;
+        stats.track_ms /= frames;
+        stats.detections /= frames;
+        stats.confirmed_tracks /= frames;
+    }
+    return stats;
+}
+
+int main( int argc, char **argv )
+{
+    if(pcl::console::find_switch(argc, argv, "--help"))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    int n_people = 5;
+    int frames = 100;
+    double rate = 10.0;
+    int clutter = 3;
+    int seed = 1;
+    float noise = 0.0015f;
+    float camera_height = DEFAULT_SYNTHETIC_CAMERA_HEIGHT;
+    std::string string_intrinsic = "525 0.0 319.5 0.0 525 239.5 0.0 0.0 1.0";
+    std::string pcd_dir;
+    std::string svm_filename;
+    double min_confidence = DEFAULT_MIN_CONFIDENCE;
+    std::string record_path;
+    int scaling_max = 0;
+    int scaling_step = 10;
+    std::string output_path;
+    pcl::console::parse_argument(argc, argv, "--people", n_people);
+    pcl::console::parse_argument(argc, argv, "--frames", frames);
+    pcl::console::parse_argument(argc, argv, "--rate", rate);
+    pcl::console::parse_argument(argc, argv, "--clutter", clutter);
+    pcl::console::parse_argument(argc, argv, "--seed", seed);
+    pcl::console::parse_argument(argc, argv, "--noise", noise);
+    pcl::console::parse_argument(argc, argv, "--camera-height", camera_height);
+    pcl::console::parse_argument(argc, argv, "--rgb-intrinsic", string_intrinsic);
+    pcl::console::parse_argument(argc, argv, "--pcd-dir", pcd_dir);
+    pcl::console::parse_argument(argc, argv, "--svm", svm_filename);
+    pcl::console::parse_argument(argc, argv, "--min-confidence", min_confidence);
+    pcl::console::parse_argument(argc, argv, "--record", record_path);
+    pcl::console::parse_argument(argc, argv, "--scaling-max", scaling_max);
+    pcl::console::parse_argument(argc, argv, "--scaling-step", scaling_step);
+    pcl::console::parse_argument(argc, argv, "--output", output_path);
+    bool stream = pcl::console::find_switch(argc, argv, "--stream") || (scaling_max > 0);
+    bool compact = pcl::console::find_switch(argc, argv, "--compact");
+    if(pcd_dir.empty() && !stream)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if(scaling_step < 1)
+        scaling_step = 1;
+
+    Eigen::Matrix3f rgb_intrinsic = PeopleDetector::IntrinsicParamtoMatrix3f(string_intrinsic);
+    SyntheticCrowd crowd(rgb_intrinsic, DEFAULT_SYNTHETIC_WIDTH, DEFAULT_SYNTHETIC_HEIGHT, camera_height);
+    crowd.setDepthNoise(noise);
+
+    //PCD sequence
+    if(!pcd_dir.empty())
+    {
+        crowd.addRandomCrowd(n_people, DEFAULT_CROWD_X_RANGE, DEFAULT_CROWD_Z_MIN, DEFAULT_CROWD_Z_MAX, seed);
+        crowd.addRandomClutter(clutter, DEFAULT_CROWD_X_RANGE, DEFAULT_CROWD_Z_MIN, DEFAULT_CROWD_Z_MAX, seed + 1);
+        FILE *gt_file = fopen((pcd_dir + "/ground_truth.txt").c_str(), "w");
+        FILE *coeffs_file = fopen((pcd_dir + "/ground_coeffs.txt").c_str(), "w");
+        if((gt_file == NULL) || (coeffs_file == NULL))
+        {
+            std::cout << "Cannot write to " << pcd_dir << std::endl;
+            return 1;
+        }
+        Eigen::VectorXf coeffs = crowd.getGroundCoeffs();
+        fprintf(coeffs_file, "%f %f %f %f\n", coeffs(0), coeffs(1), coeffs(2), coeffs(3));
+        fclose(coeffs_file);
+
+        PointCloudT cloud;
+        std::vector<synthetic_ground_truth> ground_truth;
+        for(int f=0; f < frames; f++)
+        {
+            double stamp = f/rate;
+            crowd.generate(stamp, cloud, ground_truth);
+            cloud.header.stamp = (uint64_t)(stamp*1e6);
+            char name[32];
+            snprintf(name, sizeof(name), "/frame_%05d.pcd", f);
+            pcl::io::savePCDFileBinary(pcd_dir + name, cloud);
+            for(int i=0; i < ground_truth.size(); i++)
+                fprintf(gt_file, "%d %d %.6f %.6f %.6f\n", f, ground_truth[i].id,
+                        ground_truth[i].center(0), ground_truth[i].center(1), ground_truth[i].center(2));
+        }
+        fclose(gt_file);
+        std::cout << "Wrote " << frames << " frames to " << pcd_dir << std::endl;
+        crowd.clear();
+    }
+    if(!stream)
+        return 0;
+
+    //In-process stream
+    if(svm_filename.empty())
+        svm_filename = ros::package::getPath("people_detection") + "/trainedLinearSVMForPeopleDetectionWithHOG.yaml";
+    PeopleDetector detector;
+    detector.initPeopleDetector(svm_filename, rgb_intrinsic, DEFAULT_MIN_HEIGHT, DEFAULT_MAX_HEIGHT, min_confidence,
+                                DEFAULT_HEAD_MINIMUM_DISTANCE, DEFAULT_CROWD_Z_MAX + 1.0);
+
+    DetectionLogWriter log;
+    if(!record_path.empty() && !log.open(record_path))
+    {
+        std::cout << "Cannot open detection log (or not a detection log version " << DETECTION_LOG_VERSION << "): " << record_path << std::endl;
+        return 1;
+    }
+    if(log.getDroppedBytes() > 0)
+        std::cout << "Detection log ended in an incomplete frame: " << log.getDroppedBytes() << " bytes dropped" << std::endl;
+    FILE *out = stdout;
+    if(!output_path.empty())
+    {
+        out = fopen(output_path.c_str(), "w");
+        if(out == NULL)
+        {
+            std::cout << "Cannot open output: " << output_path << std::endl;
+            return 1;
+        }
+    }
+
+    if(scaling_max < n_people)
+        scaling_max = n_people;
+    fprintf(out, "people,generate_ms,detect_ms,track_ms,detections_per_frame,confirmed_tracks_per_frame\n");
+    for(int n=n_people; n <= scaling_max; n += scaling_step)
+    {
+        crowd.clear();
+        crowd.addRandomCrowd(n, DEFAULT_CROWD_X_RANGE, DEFAULT_CROWD_Z_MIN, DEFAULT_CROWD_Z_MAX, seed);
+        crowd.addRandomClutter(clutter, DEFAULT_CROWD_X_RANGE, DEFAULT_CROWD_Z_MIN, DEFAULT_CROWD_Z_MAX, seed + 1);
+        stream_stats stats = runStream(crowd, &detector, n, frames, rate, compact, log.isOpen() ? &log : NULL);
+        fprintf(out, "%d,%.3lf,%.3lf,%.3lf,%.2lf,%.2lf\n", stats.people, stats.generate_ms, stats.detect_ms, stats.track_ms,
+                stats.detections, stats.confirmed_tracks);
+        fflush(out);
+    }
+    if(out != stdout)
+        fclose(out);
+    return 0;
+}
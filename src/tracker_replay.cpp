@@ -0,0 +1,104 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// Replay a DetectionLog through PeopleTracker, one output line per track per frame:
+// frame stamp id istrack x y z
+//
+
+#include <cstdio>
+#include <pcl/console/parse.h>
+#include <PeopleTracker.h>
+#include <DetectionLog.h>
+
+
+void printUsage(const char *prog)
+{
+    std::cout << "Usage: " << prog << " <detections.log> [options]" << std::endl
+              << "  --algorithm N        0:SINGLE_NEAREST_NEIGHBOR_TRACKER, 1:MULTI_NEAREST_NEIGHBOR_TRACKER (default 1)" << std::endl
+              << "  --update N           0:UPDATE_NORMAL, 1:UPDATE_WITH_FRAME_COUNT (default 1)" << std::endl
+              << "  --track-distance F   maximum range to track between frames (default 0.3)" << std::endl
+              << "  --get-in N           get_in_condition (default " << DEFAULT_GET_IN_TRACK_CONDITION << ")" << std::endl
+              << "  --get-in-check N     get_in_check (default " << DEFAULT_GET_IN_TRACK_CHECK_FRAME << ")" << std::endl
+              << "  --out N              out_track_condition (default " << DEFAULT_OUT_OF_TRACK_CONDITION << ")" << std::endl
+              << "  --reset-distance F   single tracker reset distance (default 1.0)" << std::endl
+              << "  --output FILE        track output (default stdout)" << std::endl
+              << "  --no-output          only report replay speed" << std::endl;
+}
+
+int main( int argc, char **argv )
+{
+    if((argc < 2) || pcl::console::find_switch(argc, argv, "--help"))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int algorithm = MULTI_NEAREST_NEIGHBOR_TRACKER;
+    int update_method = UPDATE_WITH_FRAME_COUNT;
+    float track_distance = 0.3f;
+    int get_in = DEFAULT_GET_IN_TRACK_CONDITION;
+    int get_in_check = DEFAULT_GET_IN_TRACK_CHECK_FRAME;
+    int out_track = DEFAULT_OUT_OF_TRACK_CONDITION;
+    float reset_distance = 1.0f;
+    std::string output_path;
+    pcl::console::parse_argument(argc, argv, "--algorithm", algorithm);
+    pcl::console::parse_argument(argc, argv, "--update", update_method);
+    pcl::console::parse_argument(argc, argv, "--track-distance", track_distance);
+    pcl::console::parse_argument(argc, argv, "--get-in", get_in);
+    pcl::console::parse_argument(argc, argv, "--get-in-check", get_in_check);
+    pcl::console::parse_argument(argc, argv, "--out", out_track);
+    pcl::console::parse_argument(argc, argv, "--reset-distance", reset_distance);
+    pcl::console::parse_argument(argc, argv, "--output", output_path);
+    bool write_output = !pcl::console::find_switch(argc, argv, "--no-output");
+
+    DetectionLogReader log;
+    if(!log.open(argv[1]))
+    {
+        std::cout << "Cannot open detection log: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    FILE *out = stdout;
+    if(write_output && !output_path.empty())
+    {
+        out = fopen(output_path.c_str(), "w");
+        if(out == NULL)
+        {
+            std::cout << "Cannot open output: " << output_path << std::endl;
+            return 1;
+        }
+    }
+
+    PeopleTracker tracker;
+    tracker.setVerbose(false);
+    tracker.setTrackThreshold(track_distance);
+    tracker.setListUpdateConstraints(get_in, get_in_check, out_track);
+    tracker.setSingleTrackResetDistance(reset_distance);
+
+    std::vector<person> track_list;
+    std::vector<Eigen::Vector3f> centers;
+    std::vector<float> confidences;
+    ros::WallTime start = ros::WallTime::now();
+    for(int f=0; f < log.size(); f++)
+    {
+        double stamp = log.getStamp(f);
+        log.getFrame(f, centers, confidences);
+        tracker.setFrameStamp(stamp);
+        tracker.setFrameConfidences(confidences);
+        tracker.trackPeople(track_list, centers, algorithm, update_method);
+        if(!write_output)
+            continue;
+        for(int i=0; i < track_list.size(); i++)
+        {
+            const person &p = track_list[i];
+            fprintf(out, "%d %.6f %d %d %.6f %.6f %.6f\n", f, stamp, p.id, p.istrack ? 1 : 0, p.points(0), p.points(1), p.points(2));
+        }
+    }
+    double elapsed = (ros::WallTime::now() - start).toSec();
+    if(out != stdout)
+        fclose(out);
+
+    fprintf(stderr, "Replayed %d frames in %.3lf s (%.0lf frames/s)\n", log.size(), elapsed,
+            (elapsed > 0.0) ? log.size()/elapsed : 0.0);
+    return 0;
+}
@@ -0,0 +1,385 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// Parameter sweep of PeopleTracker configurations over a recorded DetectionLog,
+// scored against a ground truth track file and written as a ranked CSV.
+//
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <pcl/console/parse.h>
+#include <PeopleTracker.h>
+#include <DetectionLog.h>
+
+
+#define DEFAULT_MATCH_DISTANCE 0.5
+
+#define SCORE_ID_SWITCH_WEIGHT 10.0
+#define SCORE_FRAGMENTATION_WEIGHT 5.0
+
+typedef struct{
+    int algorithm;
+    int update_method;
+    float track_distance;
+    int get_in;
+    int get_in_check;
+    int out_track;
+    float reset_distance;
+}tracker_config;
+
+typedef struct{
+    int id;
+    Eigen::Vector3f points;
+}gt_person;
+
+typedef struct{
+    tracker_config config;
+    int id_switches;
+    int fragmentations;
+    double mean_confirm_latency; //frames from first ground truth appearance to first match
+    int unconfirmed; //ground truth persons never matched
+    int misses;
+    int false_positives;
+    double score;
+}sweep_result;
+
+//Ground truth file: one "frame gt_id x y z" line per visible person, frame = index in the detection log
+bool loadGroundTruth(std::string filename, int frame_count, std::vector<std::vector<gt_person> > &ground_truth)
+{
+    std::ifstream file(filename.c_str());
+    if(!file.is_open())
+        return false;
+    ground_truth.assign(frame_count, std::vector<gt_person>());
+    std::string line;
+    while(std::getline(file, line))
+    {
+        std::istringstream is(line);
+        int frame;
+        gt_person p;
+        float x, y, z;
+        if(!(is >> frame >> p.id >> x >> y >> z))
+            continue;
+        if((frame < 0) || (frame >= frame_count))
+            continue;
+        p.points << x, y, z;
+        ground_truth[frame].push_back(p);
+    }
+    return true;
+}
+
+//Sweep file: one "name value..." line per parameter, every value is swept (grid) or "name min max" (--random).
+//Names: algorithm update track_distance get_in get_in_check out reset_distance
+bool loadSweepValues(std::string filename, std::map<std::string, std::vector<double> > &values)
+{
+    std::ifstream file(filename.c_str());
+    if(!file.is_open())
+        return false;
+    std::string line;
+    while(std::getline(file, line))
+    {
+        std::istringstream is(line);
+        std::string name;
+        if(!(is >> name) || (name[0] == '#'))
+            continue;
+        double v;
+        while(is >> v)
+            values[name].push_back(v);
+    }
+    return true;
+}
+
+void setConfigValue(tracker_config &config, const std::string &name, double v)
+{
+    if(name == "algorithm") config.algorithm = (int)v;
+    else if(name == "update") config.update_method = (int)v;
+    else if(name == "track_distance") config.track_distance = (float)v;
+    else if(name == "get_in") config.get_in = (int)v;
+    else if(name == "get_in_check") config.get_in_check = (int)v;
+    else if(name == "out") config.out_track = (int)v;
+    else if(name == "reset_distance") config.reset_distance = (float)v;
+    else std::cout << "Unknown sweep parameter: " << name << std::endl;
+}
+
+bool isIntegerParameter(const std::string &name)
+{
+    return (name == "algorithm") || (name == "update") || (name == "get_in") || (name == "get_in_check") || (name == "out");
+}
+
+void buildGrid(const tracker_config &base, const std::map<std::string, std::vector<double> > &values, std::vector<tracker_config> &configs)
+{
+    configs.clear();
+    configs.push_back(base);
+    for(std::map<std::string, std::vector<double> >::const_iterator it = values.begin(); it != values.end(); ++it)
+    {
+        std::vector<tracker_config> expanded;
+        for(int c=0; c < configs.size(); c++)
+        {
+            for(int v=0; v < it->second.size(); v++)
+            {
+                tracker_config config = configs[c];
+                setConfigValue(config, it->first, it->second[v]);
+                expanded.push_back(config);
+            }
+        }
+        configs.swap(expanded);
+    }
+}
+
+void buildRandom(const tracker_config &base, const std::map<std::string, std::vector<double> > &values, int count,
+                 unsigned int seed, std::vector<tracker_config> &configs)
+{
+    configs.assign(count, base);
+    for(int c=0; c < count; c++)
+    {
+        for(std::map<std::string, std::vector<double> >::const_iterator it = values.begin(); it != values.end(); ++it)
+        {
+            if(it->second.size() < 2)
+            {
+                setConfigValue(configs[c], it->first, it->second[0]);
+                continue;
+            }
+            double lo = it->second[0];
+            double hi = it->second[1];
+            double u = (double)rand_r(&seed)/RAND_MAX;
+            double v = isIntegerParameter(it->first) ? floor(lo + u*(hi - lo + 1.0)) : lo + u*(hi - lo);
+            setConfigValue(configs[c], it->first, std::min(v, hi));
+        }
+    }
+}
+
+//Greedy nearest matching of confirmed tracks to ground truth persons, within match_distance
+void matchFrame(const std::vector<person> &tracks, const std::vector<gt_person> &gt, float match_distance,
+                std::vector<int> &gt_to_track, int &unmatched_tracks)
+{
+    gt_to_track.assign(gt.size(), -1);
+    std::vector<bool> track_used(tracks.size(), false);
+    while(true)
+    {
+        float best = match_distance;
+        int best_gt = -1;
+        int best_track = -1;
+        for(int g=0; g < gt.size(); g++)
+        {
+            if(gt_to_track[g] >= 0)
+                continue;
+            for(int t=0; t < tracks.size(); t++)
+            {
+                if(track_used[t] || !tracks[t].istrack)
+                    continue;
+                float d = (tracks[t].points - gt[g].points).norm();
+                if(d < best)
+                {
+                    best = d;
+                    best_gt = g;
+                    best_track = t;
+                }
+            }
+        }
+        if(best_gt < 0)
+            break;
+        gt_to_track[best_gt] = tracks[best_track].id;
+        track_used[best_track] = true;
+    }
+    unmatched_tracks = 0;
+    for(int t=0; t < tracks.size(); t++)
+    {
+        if(tracks[t].istrack && !track_used[t])
+            unmatched_tracks++;
+    }
+}
+
+void evaluateConfig(const DetectionLogReader &log, const std::vector<std::vector<gt_person> > &ground_truth,
+                    float match_distance, sweep_result &result)
+{
+    //Everything here is local to the worker: one tracker per configuration, nothing shared but the read-only inputs
+    const tracker_config &config = result.config;
+    PeopleTracker tracker;
+    tracker.setVerbose(false);
+    tracker.setTrackThreshold(config.track_distance);
+    tracker.setListUpdateConstraints(config.get_in, config.get_in_check, config.out_track);
+    tracker.setSingleTrackResetDistance(config.reset_distance);
+
+    std::map<int, int> last_track;    //gt id -> last matched track id
+    std::map<int, bool> matched_last; //gt id -> matched in its previous visible frame
+    std::map<int, int> first_seen;    //gt id -> first frame
+    std::map<int, int> confirm_latency;
+    result.id_switches = 0;
+    result.fragmentations = 0;
+    result.misses = 0;
+    result.false_positives = 0;
+
+    std::vector<person> track_list;
+    std::vector<Eigen::Vector3f> centers;
+    std::vector<float> confidences;
+    std::vector<int> gt_to_track;
+    for(int f=0; f < log.size(); f++)
+    {
+        log.getFrame(f, centers, confidences);
+        tracker.setFrameStamp(log.getStamp(f));
+        tracker.setFrameConfidences(confidences);
+        tracker.trackPeople(track_list, centers, config.algorithm, config.update_method);
+
+        const std::vector<gt_person> &gt = ground_truth[f];
+        int unmatched_tracks;
+        matchFrame(track_list, gt, match_distance, gt_to_track, unmatched_tracks);
+        result.false_positives += unmatched_tracks;
+        for(int g=0; g < gt.size(); g++)
+        {
+            int id = gt[g].id;
+            if(first_seen.find(id) == first_seen.end())
+                first_seen[id] = f;
+            bool matched = (gt_to_track[g] >= 0);
+            if(!matched)
+            {
+                result.misses++;
+            }
+            else
+            {
+                if(confirm_latency.find(id) == confirm_latency.end())
+                    confirm_latency[id] = f - first_seen[id];
+                std::map<int, int>::iterator last = last_track.find(id);
+                if((last != last_track.end()) && (last->second != gt_to_track[g]))
+                    result.id_switches++;
+                if((matched_last.find(id) != matched_last.end()) && !matched_last[id] && (last != last_track.end()))
+                    result.fragmentations++;
+                last_track[id] = gt_to_track[g];
+            }
+            matched_last[id] = matched;
+        }
+    }
+
+    double latency_sum = 0.0;
+    for(std::map<int, int>::iterator it = confirm_latency.begin(); it != confirm_latency.end(); ++it)
+        latency_sum += it->second;
+    result.mean_confirm_latency = confirm_latency.empty() ? 0.0 : latency_sum/confirm_latency.size();
+    result.unconfirmed = first_seen.size() - confirm_latency.size();
+    result.score = SCORE_ID_SWITCH_WEIGHT*result.id_switches + SCORE_FRAGMENTATION_WEIGHT*result.fragmentations +
+                   result.misses + result.false_positives + result.mean_confirm_latency;
+}
+
+void sweepWorker(const DetectionLogReader *log, const std::vector<std::vector<gt_person> > *ground_truth, float match_distance,
+                 std::vector<sweep_result> *results, boost::atomic<int> *next)
+{
+    while(true)
+    {
+        int i = next->fetch_add(1);
+        if(i >= results->size())
+            return;
+        evaluateConfig(*log, *ground_truth, match_distance, (*results)[i]);
+    }
+}
+
+bool compareScore(const sweep_result &a, const sweep_result &b)
+{
+    return a.score < b.score;
+}
+
+void printUsage(const char *prog)
+{
+    std::cout << "Usage: " << prog << " <detections.log> <ground_truth.txt> <sweep.txt> [options]" << std::endl
+              << "  ground_truth.txt: \"frame gt_id x y z\" per visible person (frame = index in the log, tracker frame)" << std::endl
+              << "  sweep.txt:        \"name v1 v2 ...\" per swept parameter, names:" << std::endl
+              << "                    algorithm update track_distance get_in get_in_check out reset_distance" << std::endl
+              << "  --random N        N random configurations, sweep.txt lines are \"name min max\" (default: full grid)" << std::endl
+              << "  --seed S          random seed (default 1)" << std::endl
+              << "  --threads N       worker threads (default: all cores)" << std::endl
+              << "  --match-distance F  ground truth match distance (default " << DEFAULT_MATCH_DISTANCE << ")" << std::endl
+              << "  --output FILE     ranked CSV (default sweep_results.csv)" << std::endl
+              << "Score (lower is better) = " << SCORE_ID_SWITCH_WEIGHT << "*id_switches + " << SCORE_FRAGMENTATION_WEIGHT
+              << "*fragmentations + misses + false_positives + mean_confirm_latency" << std::endl;
+}
+
+int main( int argc, char **argv )
+{
+    if((argc < 4) || pcl::console::find_switch(argc, argv, "--help"))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    int random_count = 0;
+    int seed = 1;
+    int threads = boost::thread::hardware_concurrency();
+    float match_distance = DEFAULT_MATCH_DISTANCE;
+    std::string output_path = "sweep_results.csv";
+    pcl::console::parse_argument(argc, argv, "--random", random_count);
+    pcl::console::parse_argument(argc, argv, "--seed", seed);
+    pcl::console::parse_argument(argc, argv, "--threads", threads);
+    pcl::console::parse_argument(argc, argv, "--match-distance", match_distance);
+    pcl::console::parse_argument(argc, argv, "--output", output_path);
+    if(threads < 1)
+        threads = 1;
+
+    DetectionLogReader log;
+    if(!log.open(argv[1]))
+    {
+        std::cout << "Cannot open detection log: " << argv[1] << std::endl;
+        return 1;
+    }
+    std::vector<std::vector<gt_person> > ground_truth;
+    if(!loadGroundTruth(argv[2], log.size(), ground_truth))
+    {
+        std::cout << "Cannot open ground truth: " << argv[2] << std::endl;
+        return 1;
+    }
+    std::map<std::string, std::vector<double> > values;
+    if(!loadSweepValues(argv[3], values))
+    {
+        std::cout << "Cannot open sweep file: " << argv[3] << std::endl;
+        return 1;
+    }
+
+    tracker_config base;
+    base.algorithm = MULTI_NEAREST_NEIGHBOR_TRACKER;
+    base.update_method = UPDATE_WITH_FRAME_COUNT;
+    base.track_distance = 0.3f;
+    base.get_in = DEFAULT_GET_IN_TRACK_CONDITION;
+    base.get_in_check = DEFAULT_GET_IN_TRACK_CHECK_FRAME;
+    base.out_track = DEFAULT_OUT_OF_TRACK_CONDITION;
+    base.reset_distance = 1.0f;
+    std::vector<tracker_config> configs;
+    if(random_count > 0)
+        buildRandom(base, values, random_count, (unsigned int)seed, configs);
+    else
+        buildGrid(base, values, configs);
+
+    std::vector<sweep_result> results(configs.size());
+    for(int i=0; i < configs.size(); i++)
+        results[i].config = configs[i];
+
+    std::cout << "Evaluating " << results.size() << " configurations on " << log.size() << " frames with "
+              << threads << " threads" << std::endl;
+    ros::WallTime start = ros::WallTime::now();
+    boost::atomic<int> next(0);
+    boost::thread_group workers;
+    for(int t=0; t < threads; t++)
+        workers.create_thread(boost::bind(&sweepWorker, &log, &ground_truth, match_distance, &results, &next));
+    workers.join_all();
+    std::cout << "Done in " << (ros::WallTime::now() - start).toSec() << " s" << std::endl;
+
+    std::stable_sort(results.begin(), results.end(), compareScore);
+    FILE *out = fopen(output_path.c_str(), "w");
+    if(out == NULL)
+    {
+        std::cout << "Cannot open output: " << output_path << std::endl;
+        return 1;
+    }
+    fprintf(out, "rank,score,algorithm,update,track_distance,get_in,get_in_check,out,reset_distance,"
+                 "id_switches,fragmentations,mean_confirm_latency,unconfirmed,misses,false_positives\n");
+    for(int i=0; i < results.size(); i++)
+    {
+        const sweep_result &r = results[i];
+        fprintf(out, "%d,%.3lf,%d,%d,%.3f,%d,%d,%d,%.3f,%d,%d,%.3lf,%d,%d,%d\n", i+1, r.score,
+                r.config.algorithm, r.config.update_method, r.config.track_distance, r.config.get_in, r.config.get_in_check,
+                r.config.out_track, r.config.reset_distance, r.id_switches, r.fragmentations, r.mean_confirm_latency,
+                r.unconfirmed, r.misses, r.false_positives);
+    }
+    fclose(out);
+    std::cout << "Wrote " << output_path << std::endl;
+    return 0;
+}
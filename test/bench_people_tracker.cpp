@@ -0,0 +1,192 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// trackPeople throughput for every algorithm x list update method, tracks and detections from 1 to 500.
+// BM_BasicPeopleTracker: BasicPeopleTracker<MultiNNAssociation, FrameCountLifecycle> without the front-end.
+// BM_ShardedTrackPeople: the same scene through ShardedPeopleTracker for 1, 2 and 4 threads.
+// allocs_per_call counts operator new calls inside trackPeople (global counter below).
+//
+
+#include <benchmark/benchmark.h>
+#include <PeopleTracker.h>
+#include <ShardedPeopleTracker.h>
+#include <cstdlib>
+#include <new>
+
+
+static size_t g_allocations = 0;
+
+void* operator new(size_t size)
+{
+    g_allocations++;
+    void *p = malloc(size == 0 ? 1 : size);
+    if(p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) throw()
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) throw()
+{
+    free(p);
+}
+
+
+//n people on a grid 0.8 m apart, each moving 5 cm per frame: every detection matches its own track
+static void makeFrame(int n, int frame, std::vector<Eigen::Vector3f> &centers)
+{
+    int side = (int)ceil(sqrt((double)n));
+    centers.resize(n);
+    for(int i=0; i < n; i++)
+        centers[i] << 1.0f + 0.8f*(i % side) + 0.05f*(frame % 4), 0.0f, 1.0f + 0.8f*(i / side);
+}
+
+static void BM_TrackPeople(benchmark::State &state)
+{
+    int n = state.range(0);
+    int algorithm = state.range(1);
+    int method = state.range(2);
+
+    PeopleTracker tracker;
+    tracker.setVerbose(false);
+    tracker.setListUpdateConstraints(DEFAULT_GET_IN_TRACK_CONDITION, DEFAULT_GET_IN_TRACK_CHECK_FRAME, DEFAULT_OUT_OF_TRACK_CONDITION);
+    tracker.setTrackThreshold(0.3);
+    tracker.setHistoryCapacity(n + 1, 16);
+
+    std::vector<Eigen::Vector3f> frames[4];
+    for(int f=0; f < 4; f++)
+        makeFrame(n, f, frames[f]);
+
+    //Steady state: every track confirmed before timing
+    std::vector<person> world;
+    int frame = 0;
+    for(; frame <= DEFAULT_GET_IN_TRACK_CHECK_FRAME + 1; frame++)
+    {
+        tracker.setFrameStamp(0.1*frame);
+        tracker.trackPeople(world, frames[frame % 4], algorithm, method);
+    }
+
+    size_t allocations = 0;
+    for(auto _ : state)
+    {
+        tracker.setFrameStamp(0.1*frame);
+        size_t before = g_allocations;
+        tracker.trackPeople(world, frames[frame % 4], algorithm, method);
+        allocations += g_allocations - before;
+        frame++;
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+    state.counters["tracks"] = world.size();
+    state.counters["allocs_per_call"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+
+static void trackerArguments(benchmark::internal::Benchmark *b)
+{
+    const int algorithms[] = {SINGLE_NEAREST_NEIGHBOR_TRACKER, MULTI_NEAREST_NEIGHBOR_TRACKER};
+    const int methods[] = {UPDATE_NORMAL, UPDATE_WITH_FRAME_COUNT};
+    const int sizes[] = {1, 10, 50, 100, 250, 500};
+    b->ArgNames({"n", "algorithm", "method"});
+    for(int a=0; a < 2; a++)
+        for(int m=0; m < 2; m++)
+            for(int s=0; s < 6; s++)
+                b->Args({sizes[s], algorithms[a], methods[m]});
+}
+
+BENCHMARK(BM_TrackPeople)->Apply(trackerArguments)->Unit(benchmark::kMicrosecond);
+
+//Compile time specialization, no front-end dispatch
+static void BM_BasicPeopleTracker(benchmark::State &state)
+{
+    int n = state.range(0);
+    BasicPeopleTracker<MultiNNAssociation, FrameCountLifecycle> tracker;
+    tracker.setListUpdateConstraints(DEFAULT_GET_IN_TRACK_CONDITION, DEFAULT_GET_IN_TRACK_CHECK_FRAME, DEFAULT_OUT_OF_TRACK_CONDITION);
+    tracker.setTrackThreshold(0.3);
+    tracker.setHistoryCapacity(n + 1, 16);
+
+    std::vector<Eigen::Vector3f> frames[4];
+    for(int f=0; f < 4; f++)
+        makeFrame(n, f, frames[f]);
+
+    std::vector<person> world;
+    int frame = 0;
+    for(; frame <= DEFAULT_GET_IN_TRACK_CHECK_FRAME + 1; frame++)
+    {
+        tracker.setFrameStamp(0.1*frame);
+        tracker.trackPeople(world, frames[frame % 4]);
+    }
+
+    size_t allocations = 0;
+    for(auto _ : state)
+    {
+        tracker.setFrameStamp(0.1*frame);
+        size_t before = g_allocations;
+        tracker.trackPeople(world, frames[frame % 4]);
+        allocations += g_allocations - before;
+        frame++;
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+    state.counters["tracks"] = world.size();
+    state.counters["allocs_per_call"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_BasicPeopleTracker)->Arg(1)->Arg(10)->Arg(50)->Arg(100)->Arg(250)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+//Multi NN over 2 m tiles, same scene as BM_TrackPeople
+static void BM_ShardedTrackPeople(benchmark::State &state)
+{
+    int n = state.range(0);
+    int threads = state.range(1);
+    int method = state.range(2);
+
+    ShardedPeopleTracker tracker(threads);
+    tracker.setTileSize(2.0);
+    tracker.setListUpdateConstraints(DEFAULT_GET_IN_TRACK_CONDITION, DEFAULT_GET_IN_TRACK_CHECK_FRAME, DEFAULT_OUT_OF_TRACK_CONDITION);
+    tracker.setTrackThreshold(0.3);
+    tracker.setHistoryCapacity(n + 1, 16);
+
+    std::vector<Eigen::Vector3f> frames[4];
+    for(int f=0; f < 4; f++)
+        makeFrame(n, f, frames[f]);
+
+    std::vector<person> world;
+    int frame = 0;
+    for(; frame <= DEFAULT_GET_IN_TRACK_CHECK_FRAME + 1; frame++)
+    {
+        tracker.setFrameStamp(0.1*frame);
+        tracker.trackPeople(world, frames[frame % 4], MULTI_NEAREST_NEIGHBOR_TRACKER, method);
+    }
+
+    size_t allocations = 0;
+    for(auto _ : state)
+    {
+        tracker.setFrameStamp(0.1*frame);
+        size_t before = g_allocations;
+        tracker.trackPeople(world, frames[frame % 4], MULTI_NEAREST_NEIGHBOR_TRACKER, method);
+        allocations += g_allocations - before;
+        frame++;
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+    state.counters["tracks"] = world.size();
+    state.counters["shards"] = tracker.getShardCount();
+    state.counters["allocs_per_call"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+
+static void shardedArguments(benchmark::internal::Benchmark *b)
+{
+    const int methods[] = {UPDATE_NORMAL, UPDATE_WITH_FRAME_COUNT};
+    const int sizes[] = {100, 250, 500};
+    const int threads[] = {1, 2, 4};
+    b->ArgNames({"n", "threads", "method"});
+    for(int m=0; m < 2; m++)
+        for(int s=0; s < 3; s++)
+            for(int t=0; t < 3; t++)
+                b->Args({sizes[s], threads[t], methods[m]});
+}
+
+BENCHMARK(BM_ShardedTrackPeople)->Apply(shardedArguments)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,230 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// CompactCloud conversion/crop and the CompactCloudFilter stages of the compact detection pipeline.
+//
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <limits>
+#include <CompactCloud.h>
+
+
+//Organized XYZ + packed RGB cloud as the camera driver sends it
+static sensor_msgs::PointCloud2 makeCloud(int width, int height, const std::vector<Eigen::Vector3f> &xyz,
+                                          const std::vector<Eigen::Vector3i> &rgb)
+{
+    sensor_msgs::PointCloud2 msg;
+    msg.width = width;
+    msg.height = height;
+    msg.point_step = 32;
+    msg.row_step = width*msg.point_step;
+    msg.is_bigendian = false;
+    const char *names[] = {"x", "y", "z", "rgb"};
+    const int offsets[] = {0, 4, 8, 16};
+    for(int i=0; i < 4; i++)
+    {
+        sensor_msgs::PointField field;
+        field.name = names[i];
+        field.offset = offsets[i];
+        field.datatype = sensor_msgs::PointField::FLOAT32;
+        field.count = 1;
+        msg.fields.push_back(field);
+    }
+    msg.data.assign(msg.row_step*height, 0);
+    for(int i=0; i < width*height; i++)
+    {
+        uint8_t *data = &msg.data[i*msg.point_step];
+        memcpy(data, xyz[i].data(), 3*sizeof(float));
+        data[16] = rgb[i](2);
+        data[17] = rgb[i](1);
+        data[18] = rgb[i](0);
+    }
+    return msg;
+}
+
+static compact_point makePoint(float x, float y, float z, uint8_t r = 0, uint8_t g = 0, uint8_t b = 0)
+{
+    compact_point p;
+    p.x = CompactCloud::toMillimeter(x);
+    p.y = CompactCloud::toMillimeter(y);
+    p.z = CompactCloud::toMillimeter(z);
+    p.r = r;
+    p.g = g;
+    p.b = b;
+    p.reserved = 0;
+    return p;
+}
+
+TEST(CompactCloudTest, PointIsTenBytes)
+{
+    EXPECT_EQ(10u, sizeof(compact_point));
+}
+
+TEST(CompactCloudTest, FromROSMsgCropsAndQuantizes)
+{
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<Eigen::Vector3f> xyz;
+    xyz.push_back(Eigen::Vector3f(0.1234f, -0.5f, 1.0f));
+    xyz.push_back(Eigen::Vector3f(nan, nan, nan));
+    xyz.push_back(Eigen::Vector3f(0.0f, 0.0f, 5.0f)); //beyond range
+    xyz.push_back(Eigen::Vector3f(-1.0f, 0.2f, 2.9996f));
+    std::vector<Eigen::Vector3i> rgb;
+    for(int i=0; i < 4; i++)
+        rgb.push_back(Eigen::Vector3i(10*i, 20*i, 30*i + 1));
+    sensor_msgs::PointCloud2 msg = makeCloud(2, 2, xyz, rgb);
+
+    CompactCloud cloud;
+    ASSERT_TRUE(cloud.fromROSMsg(msg, 3.0f));
+    ASSERT_EQ(2u, cloud.points.size());
+    EXPECT_EQ(123, cloud.points[0].x);
+    EXPECT_EQ(-500, cloud.points[0].y);
+    EXPECT_EQ(1000, cloud.points[0].z);
+    EXPECT_EQ(1, cloud.points[0].b);
+    EXPECT_EQ(-1000, cloud.points[1].x);
+    EXPECT_EQ(3000, cloud.points[1].z);
+    EXPECT_EQ(30, cloud.points[1].r);
+    EXPECT_EQ(60, cloud.points[1].g);
+    EXPECT_EQ(91, cloud.points[1].b);
+
+    //Image of every pixel, cropped or not
+    ASSERT_EQ(4u, cloud.image->points.size());
+    EXPECT_EQ(2u, cloud.image->width);
+    EXPECT_EQ(2u, cloud.image->height);
+    EXPECT_EQ(20, cloud.image->points[2].r);
+    EXPECT_EQ(61, cloud.image->points[2].b);
+}
+
+TEST(CompactCloudTest, FromROSMsgNeedsXYZ)
+{
+    std::vector<Eigen::Vector3f> xyz(1, Eigen::Vector3f(0.0f, 0.0f, 1.0f));
+    std::vector<Eigen::Vector3i> rgb(1, Eigen::Vector3i(0, 0, 0));
+    sensor_msgs::PointCloud2 msg = makeCloud(1, 1, xyz, rgb);
+    msg.fields[2].datatype = sensor_msgs::PointField::UINT16;
+    CompactCloud cloud;
+    EXPECT_FALSE(cloud.fromROSMsg(msg, 3.0f));
+}
+
+TEST(CompactCloudTest, FromROSMsgRejectsMalformedLayout)
+{
+    std::vector<Eigen::Vector3f> xyz(4, Eigen::Vector3f(0.0f, 0.0f, 1.0f));
+    std::vector<Eigen::Vector3i> rgb(4, Eigen::Vector3i(0, 0, 0));
+    sensor_msgs::PointCloud2 valid = makeCloud(2, 2, xyz, rgb);
+    CompactCloud cloud;
+    ASSERT_TRUE(cloud.fromROSMsg(valid, 3.0f));
+
+    sensor_msgs::PointCloud2 msg = valid;
+    msg.is_bigendian = true;
+    EXPECT_FALSE(cloud.fromROSMsg(msg, 3.0f));
+
+    //Row shorter than its points
+    msg = valid;
+    msg.row_step = msg.width*msg.point_step - 1;
+    EXPECT_FALSE(cloud.fromROSMsg(msg, 3.0f));
+
+    //z (offset 8) and rgb (offset 16) past the end of the point
+    msg = valid;
+    msg.point_step = 11;
+    EXPECT_FALSE(cloud.fromROSMsg(msg, 3.0f));
+    msg = valid;
+    msg.fields[2].offset = 29;
+    EXPECT_FALSE(cloud.fromROSMsg(msg, 3.0f));
+    msg = valid;
+    msg.fields[3].offset = 30;
+    EXPECT_FALSE(cloud.fromROSMsg(msg, 3.0f));
+    msg = valid;
+    msg.point_step = 18;
+    EXPECT_FALSE(cloud.fromROSMsg(msg, 3.0f));
+
+    //Both end exactly at point_step
+    msg = valid;
+    msg.fields[2].offset = 28;
+    msg.fields[3].offset = 29;
+    EXPECT_TRUE(cloud.fromROSMsg(msg, 3.0f));
+
+    //Data shorter than the rows
+    msg = valid;
+    msg.data.resize(msg.data.size() - 1);
+    EXPECT_FALSE(cloud.fromROSMsg(msg, 3.0f));
+}
+
+TEST(CompactCloudTest, VoxelDownsampleAveragesVoxels)
+{
+    std::vector<compact_point> in, out;
+    in.push_back(makePoint(0.010f, 0.010f, 1.000f, 100, 0, 7));
+    in.push_back(makePoint(0.030f, 0.050f, 1.010f, 201, 10, 8));
+    in.push_back(makePoint(0.130f, 0.010f, 1.000f, 50, 50, 50)); //next voxel in x
+    CompactCloudFilter filter;
+    filter.voxelDownsample(in, 0.06f, out);
+    ASSERT_EQ(2u, out.size());
+    EXPECT_EQ(20, out[0].x);
+    EXPECT_EQ(30, out[0].y);
+    EXPECT_EQ(1005, out[0].z);
+    EXPECT_EQ(150, out[0].r); //truncated as pcl::VoxelGrid
+    EXPECT_EQ(5, out[0].g);
+    EXPECT_EQ(7, out[0].b);
+    EXPECT_EQ(130, out[1].x);
+}
+
+TEST(CompactCloudTest, RemovePlaneRefitsGround)
+{
+    //Floor 1 m below the camera (y down), slightly tilted, plus a pole
+    std::vector<compact_point> in, out;
+    for(int i=0; i < 20; i++)
+        for(int j=0; j < 20; j++)
+            in.push_back(makePoint(-1.0f + 0.1f*i, 1.0f + 0.01f*j*0.1f, 1.0f + 0.1f*j));
+    for(int k=0; k < 10; k++)
+        in.push_back(makePoint(0.0f, 0.8f - 0.1f*k, 2.0f));
+    Eigen::Vector4f plane(0.0f, -1.0f, 0.0f, 1.0f);
+    CompactCloudFilter filter;
+    int inliers = filter.removePlane(in, plane, 0.06f, 100, out);
+    EXPECT_EQ(400, inliers);
+    EXPECT_EQ(10u, out.size());
+    EXPECT_LT(plane(1), 0.0f); //same side as the given normal
+    EXPECT_NEAR(1.0f, plane.head<3>().norm(), 1e-4);
+    for(int i=0; i < 400; i += 37)
+    {
+        Eigen::Vector3f pt(CompactCloud::toMeter(in[i].x), CompactCloud::toMeter(in[i].y), CompactCloud::toMeter(in[i].z));
+        EXPECT_NEAR(0.0f, plane.head<3>().dot(pt) + plane(3), 0.002f);
+    }
+
+    //Too few inliers: plane kept
+    Eigen::Vector4f kept(0.0f, -1.0f, 0.0f, 1.0f);
+    filter.removePlane(in, kept, 0.06f, 1000, out);
+    EXPECT_EQ(Eigen::Vector4f(0.0f, -1.0f, 0.0f, 1.0f), kept);
+}
+
+TEST(CompactCloudTest, EuclideanClustersLargestFirst)
+{
+    std::vector<compact_point> points;
+    for(int k=0; k < 5; k++)
+        points.push_back(makePoint(0.0f, 0.1f*k, 2.0f)); //chain of 5, 0.1 m apart
+    for(int k=0; k < 8; k++)
+        points.push_back(makePoint(-1.0f - 0.1f*k, 0.0f, 2.0f)); //chain of 8 across negative cells
+    points.push_back(makePoint(1.0f, 0.0f, 2.0f)); //single point
+    points.push_back(makePoint(0.0f, 0.62f, 2.0f)); //0.22 m from the first chain: separate
+    CompactCloudFilter filter;
+    std::vector<std::vector<int> > clusters;
+    filter.euclideanClusters(points, 0.12f, 2, 100, clusters);
+    ASSERT_EQ(2u, clusters.size());
+    ASSERT_EQ(8u, clusters[0].size());
+    EXPECT_EQ(5, clusters[0][0]);
+    EXPECT_EQ(12, clusters[0][7]);
+    ASSERT_EQ(5u, clusters[1].size());
+    for(int k=0; k < 5; k++)
+        EXPECT_EQ(k, clusters[1][k]);
+
+    filter.euclideanClusters(points, 0.12f, 1, 6, clusters);
+    ASSERT_EQ(3u, clusters.size());
+    EXPECT_EQ(5u, clusters[0].size());
+    EXPECT_EQ(1u, clusters[1].size());
+    EXPECT_EQ(13, clusters[1][0]);
+    EXPECT_EQ(14, clusters[2][0]);
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,137 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// DetectionLog: round trip, appending after a crash and refusing files that are not a log of this version.
+//
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+#include <DetectionLog.h>
+
+
+static std::string tempPath(std::string name)
+{
+    std::stringstream ss;
+    ss << "/tmp/test_detection_log_" << getpid() << "_" << name;
+    return ss.str();
+}
+
+static void writeFrame(DetectionLogWriter &writer, double stamp, int count)
+{
+    std::vector<Eigen::Vector3f> centers;
+    std::vector<float> confidences;
+    for(int i=0; i < count; i++)
+    {
+        centers.push_back(Eigen::Vector3f(i, 0.0f, 1.0f + stamp));
+        confidences.push_back(-1.0f + i);
+    }
+    ASSERT_TRUE(writer.write(stamp, centers, confidences));
+}
+
+class DetectionLogTest : public testing::Test
+{
+    protected:
+        virtual void SetUp()
+        {
+            this->filename = tempPath("log.bin");
+        }
+        virtual void TearDown()
+        {
+            remove(this->filename.c_str());
+        }
+        std::string filename;
+};
+
+TEST_F(DetectionLogTest, AppendKeepsFrames)
+{
+    DetectionLogWriter writer;
+    ASSERT_TRUE(writer.open(this->filename));
+    writeFrame(writer, 1.0, 2);
+    writer.close();
+    ASSERT_TRUE(writer.open(this->filename));
+    EXPECT_EQ(0u, writer.getDroppedBytes());
+    writeFrame(writer, 2.0, 3);
+    writer.close();
+
+    DetectionLogReader reader;
+    ASSERT_TRUE(reader.open(this->filename));
+    ASSERT_EQ(2, reader.size());
+    std::vector<Eigen::Vector3f> centers;
+    std::vector<float> confidences;
+    reader.getFrame(1, centers, confidences);
+    EXPECT_EQ(2.0, reader.getStamp(1));
+    ASSERT_EQ(3u, centers.size());
+    EXPECT_EQ(Eigen::Vector3f(2.0f, 0.0f, 3.0f), centers[2]);
+    EXPECT_EQ(1.0f, confidences[2]);
+}
+
+TEST_F(DetectionLogTest, AppendAfterCrashDropsPartialFrame)
+{
+    DetectionLogWriter writer;
+    ASSERT_TRUE(writer.open(this->filename));
+    writeFrame(writer, 1.0, 2);
+    writer.close();
+    //Killed while writing a frame of 4 detections: header and one entry on disk
+    FILE *file = fopen(this->filename.c_str(), "ab");
+    ASSERT_TRUE(file != NULL);
+    detection_log_frame frame = {3.0, 4, 0};
+    detection_log_entry entry = {1.0f, 2.0f, 3.0f, 0.5f};
+    fwrite(&frame, sizeof(frame), 1, file);
+    fwrite(&entry, sizeof(entry), 1, file);
+    fclose(file);
+
+    ASSERT_TRUE(writer.open(this->filename));
+    EXPECT_EQ(sizeof(frame) + sizeof(entry), writer.getDroppedBytes());
+    writeFrame(writer, 2.0, 1);
+    writer.close();
+
+    DetectionLogReader reader;
+    ASSERT_TRUE(reader.open(this->filename));
+    ASSERT_EQ(2, reader.size());
+    EXPECT_EQ(1.0, reader.getStamp(0));
+    EXPECT_EQ(2.0, reader.getStamp(1));
+    std::vector<Eigen::Vector3f> centers;
+    std::vector<float> confidences;
+    reader.getFrame(1, centers, confidences);
+    ASSERT_EQ(1u, centers.size());
+    EXPECT_EQ(Eigen::Vector3f(0.0f, 0.0f, 3.0f), centers[0]);
+}
+
+TEST_F(DetectionLogTest, RefusesOtherFiles)
+{
+    DetectionLogWriter writer;
+    FILE *file = fopen(this->filename.c_str(), "wb");
+    ASSERT_TRUE(file != NULL);
+    fputs("timestamp,x,y,z\n", file);
+    fclose(file);
+    EXPECT_FALSE(writer.open(this->filename));
+    EXPECT_FALSE(writer.isOpen());
+
+    //Another version
+    file = fopen(this->filename.c_str(), "wb");
+    detection_log_header header = {DETECTION_LOG_MAGIC, DETECTION_LOG_VERSION + 1};
+    fwrite(&header, sizeof(header), 1, file);
+    fclose(file);
+    EXPECT_FALSE(writer.open(this->filename));
+
+    //Shorter than a header
+    file = fopen(this->filename.c_str(), "wb");
+    fputc('P', file);
+    fclose(file);
+    EXPECT_FALSE(writer.open(this->filename));
+
+    //Untouched
+    file = fopen(this->filename.c_str(), "rb");
+    fseek(file, 0, SEEK_END);
+    EXPECT_EQ(1, ftell(file));
+    fclose(file);
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// FixedPeopleTracker: bit identical to PeopleTracker within capacity, bounded outside of it.
+//
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <PeopleTracker.h>
+#include <FixedPeopleTracker.h>
+
+
+//Random walkers with missed and spurious detections
+static std::vector<std::vector<Eigen::Vector3f> > randomScene(unsigned int seed, int n, int frames)
+{
+    std::vector<Eigen::Vector3f> pos(n), vel(n);
+    for(int i=0; i < n; i++)
+    {
+        pos[i] << 4.0f*rand_r(&seed)/RAND_MAX, 0.2f*rand_r(&seed)/RAND_MAX, 1.0f + 4.0f*rand_r(&seed)/RAND_MAX;
+        vel[i] << 0.1f*rand_r(&seed)/RAND_MAX - 0.05f, 0.0f, 0.1f*rand_r(&seed)/RAND_MAX - 0.05f;
+    }
+    std::vector<std::vector<Eigen::Vector3f> > scene(frames);
+    for(int f=0; f < frames; f++)
+    {
+        for(int i=0; i < n; i++)
+        {
+            pos[i] += vel[i];
+            if(rand_r(&seed) % 8 != 0)
+                scene[f].push_back(pos[i]);
+        }
+        if(rand_r(&seed) % 4 == 0)
+            scene[f].push_back(Eigen::Vector3f(4.0f*rand_r(&seed)/RAND_MAX, 0.0f, 1.0f + 4.0f*rand_r(&seed)/RAND_MAX));
+    }
+    return scene;
+}
+
+//Same bits, not only same values
+static bool sameBits(const person &a, const person &b)
+{
+    return (memcmp(a.points.data(), b.points.data(), sizeof(float)*3) == 0) &&
+           (memcmp(a.velocity.data(), b.velocity.data(), sizeof(float)*3) == 0) &&
+           (memcmp(a.variance.data(), b.variance.data(), sizeof(float)*3) == 0) &&
+           (memcmp(a.color.data(), b.color.data(), sizeof(float)*3) == 0) &&
+           (memcmp(&a.confidence, &b.confidence, sizeof(float)) == 0) &&
+           (a.stamp == b.stamp) && (a.id == b.id) && (a.framesage == b.framesage) &&
+           (a.incount == b.incount) && (a.outcount == b.outcount) && (a.istrack == b.istrack);
+}
+
+template<class Tracker>
+static void expectSameAsPeopleTracker(Tracker &fixed, int algorithm, int method)
+{
+    PeopleTracker tracker;
+    tracker.setVerbose(false);
+    std::vector<person> world;
+    for(unsigned int seed=1; seed <= 5; seed++)
+    {
+        std::vector<std::vector<Eigen::Vector3f> > scene = randomScene(seed, 10, 80);
+        for(int f=0; f < scene.size(); f++)
+        {
+            std::vector<float> confidences(scene[f].size());
+            for(int i=0; i < confidences.size(); i++)
+                confidences[i] = 0.5f + 0.01f*i;
+            tracker.setFrameStamp(0.1*f);
+            tracker.setFrameConfidences(confidences);
+            tracker.trackPeople(world, scene[f], algorithm, method);
+            fixed.setFrameStamp(0.1*f);
+            ASSERT_EQ(FIXED_TRACKER_OK, fixed.trackPeople(scene[f].data(), confidences.data(), scene[f].size()));
+            ASSERT_EQ(world.size(), fixed.size()) << "seed " << seed << " frame " << f;
+            for(int i=0; i < world.size(); i++)
+                EXPECT_TRUE(sameBits(world[i], fixed[i])) << "seed " << seed << " frame " << f << " track " << i;
+        }
+    }
+}
+
+TEST(FixedPeopleTrackerTest, MultiNNFrameCountMatchesPeopleTracker)
+{
+    FixedPeopleTracker<64, 16, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT> fixed;
+    expectSameAsPeopleTracker(fixed, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+}
+
+TEST(FixedPeopleTrackerTest, MultiNNNormalMatchesPeopleTracker)
+{
+    FixedPeopleTracker<64, 16, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL> fixed;
+    expectSameAsPeopleTracker(fixed, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+}
+
+TEST(FixedPeopleTrackerTest, SingleNNFrameCountMatchesPeopleTracker)
+{
+    FixedPeopleTracker<1, 16, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT> fixed;
+    expectSameAsPeopleTracker(fixed, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+}
+
+TEST(FixedPeopleTrackerTest, SingleNNNormalMatchesPeopleTracker)
+{
+    FixedPeopleTracker<1, 16, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL> fixed;
+    expectSameAsPeopleTracker(fixed, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+}
+
+TEST(FixedPeopleTrackerTest, OverCapacityIsTruncated)
+{
+    FixedPeopleTracker<4, 6> fixed;
+    std::vector<Eigen::Vector3f> centers;
+    for(int i=0; i < 8; i++)
+        centers.push_back(Eigen::Vector3f(1.0f*i, 0.0f, 2.0f));
+
+    int status = fixed.trackPeople(centers.data(), NULL, centers.size());
+    EXPECT_TRUE(status & FIXED_TRACKER_DETECTIONS_DROPPED);
+    EXPECT_TRUE(status & FIXED_TRACKER_TRACKS_DROPPED);
+    ASSERT_EQ(4, fixed.size());
+    for(int i=0; i < fixed.size(); i++)
+    {
+        EXPECT_EQ(centers[i], fixed[i].points);
+        EXPECT_EQ(0.0f, fixed[i].confidence);
+    }
+
+    //Same people next frame: all matched, nothing dropped
+    EXPECT_EQ(FIXED_TRACKER_OK, fixed.trackPeople(centers.data(), NULL, 4));
+    EXPECT_EQ(4, fixed.size());
+}
+
+TEST(FixedPeopleTrackerTest, ClearKeepsIds)
+{
+    FixedPeopleTracker<8, 8> fixed;
+    Eigen::Vector3f center(1.0f, 0.0f, 2.0f);
+    fixed.trackPeople(&center, NULL, 1);
+    EXPECT_EQ(1, fixed[0].id);
+    fixed.clear();
+    EXPECT_EQ(0, fixed.size());
+    fixed.trackPeople(&center, NULL, 1);
+    EXPECT_EQ(2, fixed[0].id);
+    fixed.clear();
+    fixed.resetTrackID();
+    fixed.trackPeople(&center, NULL, 1);
+    EXPECT_EQ(1, fixed[0].id);
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
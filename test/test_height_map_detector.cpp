@@ -0,0 +1,154 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// HeightMapDetector candidates: people split from a merged blob, clutter and stray points dropped.
+//
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <HeightMapDetector.h>
+
+
+//Level camera 1 m above the floor: y down, ground normal (0, -1, 0), height = 1 - y
+static const Eigen::Vector4f level_ground(0.0f, -1.0f, 0.0f, 1.0f);
+
+static compact_point groundPoint(float x, float height, float z)
+{
+    compact_point p;
+    p.x = CompactCloud::toMillimeter(x);
+    p.y = CompactCloud::toMillimeter(1.0f - height);
+    p.z = CompactCloud::toMillimeter(z);
+    p.r = p.g = p.b = 0;
+    p.reserved = 0;
+    return p;
+}
+
+//Body cylinder up to the shoulders and a head on top, sampled every 5 cm
+static int addPerson(std::vector<compact_point> &points, float x, float z, float person_height)
+{
+    int first = points.size();
+    for(float h=0.1f; h <= person_height - 0.25f; h += 0.05f)
+        for(int a=0; a < 12; a++)
+            points.push_back(groundPoint(x + 0.18f*cosf(a*M_PI/6), h, z + 0.18f*sinf(a*M_PI/6)));
+    for(float h=person_height - 0.25f; h <= person_height + 1e-3f; h += 0.05f)
+        for(int a=0; a < 6; a++)
+            points.push_back(groundPoint(x + 0.08f*cosf(a*M_PI/3), h, z + 0.08f*sinf(a*M_PI/3)));
+    return first;
+}
+
+TEST(HeightMapDetectorTest, SplitsTouchingPeople)
+{
+    std::vector<compact_point> points;
+    int a = addPerson(points, 0.0f, 2.0f, 1.8f);
+    int b = addPerson(points, 0.4f, 2.0f, 1.6f); //shoulders touch: one component
+    int end = points.size();
+
+    HeightMapDetector detector;
+    std::vector<std::vector<int> > candidates;
+    detector.detect(points, level_ground, 1.3f, 2.3f, 0.2f, 20, candidates);
+    ASSERT_EQ(2u, candidates.size());
+    ASSERT_EQ(2u, detector.getHeads().size());
+    EXPECT_EQ(detector.getHeads()[0].component, detector.getHeads()[1].component);
+
+    //Highest first, every point to its own person
+    int own = 0;
+    for(int k=0; k < candidates[0].size(); k++)
+        own += (candidates[0][k] >= a) && (candidates[0][k] < b);
+    EXPECT_EQ(b - a, own);
+    own = 0;
+    for(int k=0; k < candidates[1].size(); k++)
+        own += (candidates[1][k] >= b) && (candidates[1][k] < end);
+    EXPECT_EQ(end - b, own);
+    EXPECT_EQ(end - a, candidates[0].size() + candidates[1].size());
+    EXPECT_NEAR(1.8f, detector.getHeads()[0].height, 0.01f);
+    EXPECT_NEAR(1.6f, detector.getHeads()[1].height, 0.01f);
+}
+
+TEST(HeightMapDetectorTest, DropsClutterAndStrayPoints)
+{
+    std::vector<compact_point> points;
+    //Table: below min_height
+    for(float x=-1.0f; x <= 0.0f; x += 0.05f)
+        for(float z=3.0f; z <= 3.6f; z += 0.05f)
+            points.push_back(groundPoint(x, 0.75f, z));
+    //Stray points at head height
+    points.push_back(groundPoint(1.5f, 1.7f, 2.5f));
+    points.push_back(groundPoint(-1.5f, 1.7f, 1.5f));
+    //Points above max_height and below the ground are not projected
+    points.push_back(groundPoint(0.0f, 2.6f, 2.0f));
+    points.push_back(groundPoint(0.0f, -0.1f, 2.0f));
+
+    HeightMapDetector detector;
+    std::vector<std::vector<int> > candidates;
+    detector.detect(points, level_ground, 1.3f, 2.3f, 0.2f, 1, candidates);
+    EXPECT_TRUE(candidates.empty());
+
+    //Person next to the table: the table cells farther than the person radius are not part of it
+    int first = addPerson(points, -1.3f, 3.3f, 1.7f);
+    detector.detect(points, level_ground, 1.3f, 2.3f, 0.2f, 20, candidates);
+    ASSERT_EQ(1u, candidates.size());
+    EXPECT_EQ(first, candidates[0].front());
+    EXPECT_EQ(points.size() - 1, candidates[0].back());
+}
+
+TEST(HeightMapDetectorTest, ChannelsCountProjectedPoints)
+{
+    std::vector<compact_point> points;
+    addPerson(points, 0.0f, 2.0f, 1.7f);
+    points.push_back(groundPoint(0.0f, 2.6f, 2.0f)); //above max_height
+    HeightMapDetector detector;
+    detector.setCellSize(0.05f);
+    std::vector<std::vector<int> > candidates;
+    detector.detect(points, level_ground, 1.3f, 2.3f, 0.2f, 1, candidates);
+    const std::vector<int> &density = detector.getDensityChannel();
+    const std::vector<float> &max_height = detector.getMaxHeightChannel();
+    ASSERT_EQ(detector.getWidth()*detector.getHeight(), density.size());
+    int total = 0;
+    float top = 0.0f;
+    for(int i=0; i < density.size(); i++)
+    {
+        total += density[i];
+        top = std::max(top, max_height[i]);
+    }
+    EXPECT_EQ(points.size() - 1, total);
+    EXPECT_NEAR(1.7f, top, 0.002f);
+}
+
+TEST(HeightMapDetectorTest, TiltedGround)
+{
+    //Camera pitched down 20 degrees: same people, same candidates
+    float pitch = 20.0f*M_PI/180.0f;
+    Eigen::Matrix3f rotation;
+    rotation = Eigen::AngleAxisf(pitch, Eigen::Vector3f::UnitX());
+    std::vector<compact_point> points, tilted;
+    addPerson(points, -0.5f, 2.5f, 1.75f);
+    addPerson(points, 0.6f, 3.0f, 1.65f);
+    for(int i=0; i < points.size(); i++)
+    {
+        Eigen::Vector3f p(CompactCloud::toMeter(points[i].x), CompactCloud::toMeter(points[i].y), CompactCloud::toMeter(points[i].z));
+        p = rotation*p;
+        compact_point q = points[i];
+        q.x = CompactCloud::toMillimeter(p(0));
+        q.y = CompactCloud::toMillimeter(p(1));
+        q.z = CompactCloud::toMillimeter(p(2));
+        tilted.push_back(q);
+    }
+    Eigen::Vector3f normal = rotation*level_ground.head<3>();
+    Eigen::Vector4f ground(normal(0), normal(1), normal(2), level_ground(3));
+
+    HeightMapDetector detector;
+    std::vector<std::vector<int> > expected, candidates;
+    detector.detect(points, level_ground, 1.3f, 2.3f, 0.2f, 20, expected);
+    detector.detect(tilted, ground, 1.3f, 2.3f, 0.2f, 20, candidates);
+    ASSERT_EQ(2u, expected.size());
+    ASSERT_EQ(expected.size(), candidates.size());
+    EXPECT_EQ(expected[0].size(), candidates[0].size());
+    EXPECT_EQ(expected[1].size(), candidates[1].size());
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,161 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// PeopleDensityGrid: occupancy follows the track changes, lazily decayed dwell time matches the closed form.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <PeopleDensityGrid.h>
+
+
+//1 m cells, 10 x 10 from (0, 0)
+static void setUnitGrid(PeopleDensityGrid &grid, float decay_time)
+{
+    grid.setGeometry(1.0f, 10, 10, Eigen::Vector2f::Zero());
+    grid.setDecayTime(decay_time);
+}
+
+static void updateOne(PeopleDensityGrid &grid, int id, float x, float y, double stamp)
+{
+    std::vector<int> ids(1, id);
+    std::vector<Eigen::Vector2f> positions(1, Eigen::Vector2f(x, y));
+    grid.update(ids, positions, stamp);
+}
+
+static float densityAt(PeopleDensityGrid &grid, float x, float y, double stamp, int &occupancy)
+{
+    float density;
+    grid.getDensity(Eigen::Vector2f(x, y), 0.0f, stamp, density, occupancy);
+    return density;
+}
+
+TEST(PeopleDensityGridTest, OccupancyFollowsTracks)
+{
+    PeopleDensityGrid grid;
+    setUnitGrid(grid, 10.0f);
+    std::vector<int> ids;
+    std::vector<Eigen::Vector2f> positions;
+    ids.push_back(1); positions.push_back(Eigen::Vector2f(2.5f, 2.5f));
+    ids.push_back(2); positions.push_back(Eigen::Vector2f(2.2f, 2.8f));
+    ids.push_back(3); positions.push_back(Eigen::Vector2f(20.0f, 2.5f)); //outside
+    grid.update(ids, positions, 1.0);
+
+    int occupancy;
+    densityAt(grid, 2.5f, 2.5f, 1.0, occupancy);
+    EXPECT_EQ(2, occupancy);
+
+    //Track 2 moves, 1 is removed, 3 enters the grid
+    ids.erase(ids.begin());
+    positions.erase(positions.begin());
+    positions[0] = Eigen::Vector2f(5.5f, 2.5f);
+    positions[1] = Eigen::Vector2f(9.5f, 9.5f);
+    grid.update(ids, positions, 2.0);
+    densityAt(grid, 2.5f, 2.5f, 2.0, occupancy);
+    EXPECT_EQ(0, occupancy);
+    densityAt(grid, 5.5f, 2.5f, 2.0, occupancy);
+    EXPECT_EQ(1, occupancy);
+    densityAt(grid, 9.5f, 9.5f, 2.0, occupancy);
+    EXPECT_EQ(1, occupancy);
+
+    grid.removeAllTracks(3.0);
+    densityAt(grid, 5.5f, 2.5f, 3.0, occupancy);
+    EXPECT_EQ(0, occupancy);
+    float density;
+    EXPECT_FALSE(grid.getDensity(Eigen::Vector2f(-0.1f, 5.0f), 0.0f, 3.0, density, occupancy));
+}
+
+TEST(PeopleDensityGridTest, DwellTimeDecays)
+{
+    PeopleDensityGrid grid;
+    float tau = 5.0f;
+    setUnitGrid(grid, tau);
+
+    //Same cell every frame: only the first update touches it
+    for(int frame=0; frame <= 100; frame++)
+        updateOne(grid, 7, 3.5f + 0.001f*frame, 4.5f, 10.0 + 0.1*frame);
+    int occupancy;
+    double expected = tau*(1.0 - exp(-10.0/tau));
+    EXPECT_NEAR(expected, densityAt(grid, 3.5f, 4.5f, 20.0, occupancy), 1e-4);
+    EXPECT_EQ(1, occupancy);
+
+    //Leaves at 20 s: pure decay
+    grid.update(std::vector<int>(), std::vector<Eigen::Vector2f>(), 20.0);
+    EXPECT_NEAR(expected*exp(-3.0/tau), densityAt(grid, 3.5f, 4.5f, 23.0, occupancy), 1e-4);
+    EXPECT_EQ(0, occupancy);
+
+    //Reading does not change the cell
+    EXPECT_NEAR(expected*exp(-4.0/tau), densityAt(grid, 3.5f, 4.5f, 24.0, occupancy), 1e-4);
+}
+
+TEST(PeopleDensityGridTest, NoDecayAccumulatesDwellTime)
+{
+    PeopleDensityGrid grid;
+    setUnitGrid(grid, 0.0f);
+    updateOne(grid, 1, 0.5f, 0.5f, 0.0);
+    updateOne(grid, 1, 1.5f, 0.5f, 4.0);
+    grid.removeAllTracks(6.0);
+    int occupancy;
+    EXPECT_FLOAT_EQ(4.0f, densityAt(grid, 0.5f, 0.5f, 100.0, occupancy));
+    EXPECT_FLOAT_EQ(2.0f, densityAt(grid, 1.5f, 0.5f, 100.0, occupancy));
+
+    //Radius: both cells centers within 1 m of (1, 0.5)
+    float density;
+    ASSERT_TRUE(grid.getDensity(Eigen::Vector2f(1.0f, 0.5f), 1.0f, 100.0, density, occupancy));
+    EXPECT_FLOAT_EQ(6.0f, density);
+}
+
+TEST(PeopleDensityGridTest, ResetKeepsTheTimeBase)
+{
+    //Tracker reset at the last update stamp, tracks back on the next frame: no dwell time lost or added
+    PeopleDensityGrid grid;
+    setUnitGrid(grid, 0.0f);
+    updateOne(grid, 1, 0.5f, 0.5f, 100.0);
+    updateOne(grid, 1, 0.5f, 0.5f, 104.0);
+    grid.removeAllTracks(104.0);
+    updateOne(grid, 1, 0.5f, 0.5f, 106.0);
+    int occupancy;
+    EXPECT_FLOAT_EQ(8.0f, densityAt(grid, 0.5f, 0.5f, 110.0, occupancy));
+    EXPECT_EQ(1, occupancy);
+}
+
+TEST(PeopleDensityGridTest, ActiveCellsArePruned)
+{
+    PeopleDensityGrid grid;
+    setUnitGrid(grid, 1.0f);
+    std::vector<int> ids;
+    std::vector<Eigen::Vector2f> positions;
+    ids.push_back(1); positions.push_back(Eigen::Vector2f(8.5f, 1.5f));
+    ids.push_back(2); positions.push_back(Eigen::Vector2f(0.5f, 0.5f));
+    grid.update(ids, positions, 0.0);
+    ids.pop_back();
+    positions.pop_back();
+    grid.update(ids, positions, 1.0);
+
+    std::vector<int> cells, occupancy;
+    std::vector<float> density;
+    grid.getActiveCells(1.0, cells, density, occupancy);
+    ASSERT_EQ(2u, cells.size());
+    EXPECT_EQ(0, cells[0]); //row major
+    EXPECT_EQ(18, cells[1]);
+    EXPECT_EQ(0, occupancy[0]);
+    EXPECT_EQ(1, occupancy[1]);
+    EXPECT_NEAR(1.0 - exp(-1.0), density[0], 1e-5);
+
+    //Cell 0 decays below DENSITY_GRID_MIN_DENSITY, the occupied one stays
+    grid.getActiveCells(20.0, cells, density, occupancy);
+    ASSERT_EQ(1u, cells.size());
+    EXPECT_EQ(18, cells[0]);
+    EXPECT_NEAR(1.0, density[0], 1e-5);
+
+    grid.clear();
+    grid.getActiveCells(20.0, cells, density, occupancy);
+    EXPECT_TRUE(cells.empty());
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
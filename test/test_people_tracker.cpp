@@ -0,0 +1,263 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// PeopleTracker correctness: association, list update (normal and frame count), velocity and confidence.
+//
+
+#include <gtest/gtest.h>
+#include <PeopleTracker.h>
+
+
+class PeopleTrackerTest : public ::testing::Test
+{
+    protected:
+        virtual void SetUp()
+        {
+            this->tracker.setVerbose(false);
+            this->tracker.setListUpdateConstraints(DEFAULT_GET_IN_TRACK_CONDITION, DEFAULT_GET_IN_TRACK_CHECK_FRAME,
+                                                   DEFAULT_OUT_OF_TRACK_CONDITION);
+            this->tracker.setTrackThreshold(0.3);
+            this->stamp = 0.0;
+        }
+
+        void track(const std::vector<Eigen::Vector3f> &centers, int algorithm, int method)
+        {
+            this->tracker.setFrameStamp(this->stamp);
+            this->tracker.trackPeople(this->world, centers, algorithm, method);
+            this->stamp += 0.1;
+        }
+
+        const person* findTrack(int id)
+        {
+            for(int i=0; i < this->world.size(); i++)
+                if(this->world[i].id == id)
+                    return &this->world[i];
+            return NULL;
+        }
+
+        PeopleTracker tracker;
+        std::vector<person> world;
+        double stamp;
+};
+
+static std::vector<Eigen::Vector3f> centersAt(float x0, int n, float spacing = 1.0f)
+{
+    std::vector<Eigen::Vector3f> centers;
+    for(int i=0; i < n; i++)
+        centers.push_back(Eigen::Vector3f(x0 + spacing*i, 0.0f, 2.0f));
+    return centers;
+}
+
+
+TEST_F(PeopleTrackerTest, MultiNNEmptyInputKeepsEmptyWorld)
+{
+    std::vector<Eigen::Vector3f> none;
+    this->track(none, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    this->track(none, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    EXPECT_TRUE(this->world.empty());
+}
+
+TEST_F(PeopleTrackerTest, MultiNNCreatesSequentialIds)
+{
+    this->track(centersAt(0.0f, 3), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(3u, this->world.size());
+    for(int i=0; i < 3; i++)
+    {
+        EXPECT_EQ(i + 1, this->world[i].id);
+        EXPECT_TRUE(this->world[i].istrack);
+    }
+}
+
+TEST_F(PeopleTrackerTest, MultiNNKeepsIdsOfMovingPeople)
+{
+    for(int f=0; f < 10; f++)
+        this->track(centersAt(0.05f*f, 3), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(3u, this->world.size());
+    for(int id=1; id <= 3; id++)
+    {
+        const person *p = this->findTrack(id);
+        ASSERT_TRUE(p != NULL);
+        EXPECT_NEAR(0.45f + (id - 1), p->points(0), 1e-5);
+    }
+}
+
+TEST_F(PeopleTrackerTest, MultiNNAddsNewcomerNextToTrackedPerson)
+{
+    this->track(centersAt(0.0f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    this->track(centersAt(0.0f, 2), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(2u, this->world.size());
+    EXPECT_TRUE(this->findTrack(1) != NULL);
+    EXPECT_TRUE(this->findTrack(2) != NULL);
+}
+
+TEST_F(PeopleTrackerTest, MultiNNFarDetectionIsNewPersonAndTrackIsLost)
+{
+    this->track(centersAt(0.0f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    this->track(centersAt(3.0f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(1u, this->world.size());
+    EXPECT_EQ(2, this->world[0].id);
+}
+
+TEST_F(PeopleTrackerTest, NormalMethodRemovesLostTracks)
+{
+    this->track(centersAt(0.0f, 3), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    std::vector<Eigen::Vector3f> centers = centersAt(0.0f, 3);
+    centers.erase(centers.begin() + 1);
+    this->track(centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(2u, this->world.size());
+    EXPECT_TRUE(this->findTrack(2) == NULL);
+}
+
+TEST_F(PeopleTrackerTest, FrameCountConfirmsAfterCheckFrame)
+{
+    for(int f=0; f < DEFAULT_GET_IN_TRACK_CHECK_FRAME; f++)
+    {
+        this->track(centersAt(0.0f, 2), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+        ASSERT_EQ(2u, this->world.size());
+        EXPECT_FALSE(this->world[0].istrack);
+    }
+    this->track(centersAt(0.0f, 2), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    ASSERT_EQ(2u, this->world.size());
+    EXPECT_TRUE(this->world[0].istrack);
+    EXPECT_TRUE(this->world[1].istrack);
+    EXPECT_EQ(DEFAULT_OUT_OF_TRACK_CONDITION, this->world[0].outcount);
+}
+
+TEST_F(PeopleTrackerTest, FrameCountCullsFlickeringTentativeTrack)
+{
+    //Missed get_in_condition times before the check frame: never confirmed
+    std::vector<Eigen::Vector3f> none;
+    this->track(centersAt(0.0f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    for(int f=0; f < DEFAULT_GET_IN_TRACK_CONDITION; f++)
+        this->track(none, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    for(int f=0; f < DEFAULT_GET_IN_TRACK_CHECK_FRAME; f++)
+        this->track(centersAt(0.0f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    for(int i=0; i < this->world.size(); i++)
+        EXPECT_NE(1, this->world[i].id);
+}
+
+TEST_F(PeopleTrackerTest, FrameCountRemovesAllLostTracksInOneFrame)
+{
+    //Consecutive removals must not skip the element after an erase
+    for(int f=0; f <= DEFAULT_GET_IN_TRACK_CHECK_FRAME; f++)
+        this->track(centersAt(0.0f, 4), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    ASSERT_EQ(4u, this->world.size());
+
+    std::vector<Eigen::Vector3f> none;
+    for(int f=0; f < DEFAULT_OUT_OF_TRACK_CONDITION - 1; f++)
+    {
+        this->track(none, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+        ASSERT_EQ(4u, this->world.size());
+        EXPECT_EQ(DEFAULT_OUT_OF_TRACK_CONDITION - 1 - f, this->world[0].outcount);
+    }
+    this->track(none, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    EXPECT_TRUE(this->world.empty());
+}
+
+TEST_F(PeopleTrackerTest, FrameCountRefreshesOutcountOnMatch)
+{
+    for(int f=0; f <= DEFAULT_GET_IN_TRACK_CHECK_FRAME; f++)
+        this->track(centersAt(0.0f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    std::vector<Eigen::Vector3f> none;
+    this->track(none, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    this->track(none, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    this->track(centersAt(0.0f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    ASSERT_EQ(1u, this->world.size());
+    EXPECT_EQ(DEFAULT_OUT_OF_TRACK_CONDITION, this->world[0].outcount);
+}
+
+TEST_F(PeopleTrackerTest, SingleNNNoCandidateKeepsEmptyWorld)
+{
+    std::vector<Eigen::Vector3f> none;
+    this->track(none, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    EXPECT_TRUE(this->world.empty());
+
+    //Outside the reset distance from the camera front
+    std::vector<Eigen::Vector3f> far;
+    far.push_back(Eigen::Vector3f(5.0f, 0.0f, 5.0f));
+    this->track(far, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    EXPECT_TRUE(this->world.empty());
+}
+
+TEST_F(PeopleTrackerTest, SingleNNFollowsClosestPerson)
+{
+    std::vector<Eigen::Vector3f> centers;
+    centers.push_back(Eigen::Vector3f(1.0f, 0.0f, 1.2f));
+    centers.push_back(Eigen::Vector3f(-2.0f, 0.0f, 3.0f));
+    for(int f=0; f < 5; f++)
+    {
+        this->track(centers, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+        ASSERT_EQ(1u, this->world.size());
+        EXPECT_TRUE(this->world[0].points.isApprox(centers[0]));
+        centers[0](2) += 0.05f;
+    }
+}
+
+TEST_F(PeopleTrackerTest, SingleNNPenalizesOnlyWhenLost)
+{
+    std::vector<Eigen::Vector3f> centers;
+    centers.push_back(Eigen::Vector3f(1.0f, 0.0f, 1.0f));
+    for(int f=0; f <= DEFAULT_GET_IN_TRACK_CHECK_FRAME; f++)
+        this->track(centers, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    ASSERT_EQ(1u, this->world.size());
+    EXPECT_TRUE(this->world[0].istrack);
+    EXPECT_EQ(DEFAULT_OUT_OF_TRACK_CONDITION, this->world[0].outcount);
+
+    std::vector<Eigen::Vector3f> none;
+    this->track(none, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    ASSERT_EQ(1u, this->world.size());
+    EXPECT_EQ(DEFAULT_OUT_OF_TRACK_CONDITION - 1, this->world[0].outcount);
+
+    this->track(none, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    EXPECT_TRUE(this->world.empty());
+}
+
+TEST_F(PeopleTrackerTest, VelocityFromMeasuredFrames)
+{
+    this->tracker.setVelocitySmoothing(1.0f);
+    for(int f=0; f < 5; f++)
+        this->track(centersAt(0.1f*f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(1u, this->world.size());
+    EXPECT_NEAR(1.0f, this->world[0].velocity(0), 1e-3);
+    EXPECT_NEAR(0.0f, this->world[0].velocity(2), 1e-3);
+
+    Eigen::Vector3f predicted = PeopleTracker::extrapolatePosition(this->world[0], this->world[0].stamp + 0.2, 1.0);
+    EXPECT_NEAR(this->world[0].points(0) + 0.2f, predicted(0), 1e-3);
+    predicted = PeopleTracker::extrapolatePosition(this->world[0], this->world[0].stamp + 10.0, 0.5);
+    EXPECT_NEAR(this->world[0].points(0) + 0.5f, predicted(0), 1e-3);
+}
+
+TEST_F(PeopleTrackerTest, ConfidenceOfMatchedCenter)
+{
+    std::vector<Eigen::Vector3f> centers = centersAt(0.0f, 2);
+    std::vector<float> confidences;
+    confidences.push_back(-0.5f);
+    confidences.push_back(1.5f);
+    this->tracker.setFrameConfidences(confidences);
+    this->track(centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(2u, this->world.size());
+    EXPECT_FLOAT_EQ(-0.5f, this->findTrack(1)->confidence);
+    EXPECT_FLOAT_EQ(1.5f, this->findTrack(2)->confidence);
+
+    //Not given for the next frame: 0
+    this->track(centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    EXPECT_FLOAT_EQ(0.0f, this->findTrack(1)->confidence);
+}
+
+TEST_F(PeopleTrackerTest, HistoryFollowsTrackList)
+{
+    for(int f=0; f < 3; f++)
+        this->track(centersAt(0.0f, 2), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    std::vector<track_sample> samples;
+    ASSERT_TRUE(this->tracker.getTrackHistory().getTrack(1, 0.0, samples));
+    EXPECT_EQ(3u, samples.size());
+    this->track(centersAt(0.0f, 1), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    EXPECT_FALSE(this->tracker.getTrackHistory().getTrack(2, 0.0, samples));
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
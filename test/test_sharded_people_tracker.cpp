@@ -0,0 +1,259 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// ShardedPeopleTracker: handoff across tiles, unique ids, same matches as PeopleTracker for any thread count and for
+// tracks closer than the track distance across a tile edge.
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <ShardedPeopleTracker.h>
+
+
+//n people walking along x through several tiles, 1 m apart in z
+static std::vector<Eigen::Vector3f> walkers(int n, int frame)
+{
+    std::vector<Eigen::Vector3f> centers;
+    for(int i=0; i < n; i++)
+    {
+        float dir = (i % 2) ? -1.0f : 1.0f;
+        centers.push_back(Eigen::Vector3f(dir*(-6.0f + 0.1f*frame), 0.0f, 1.0f + 1.0f*i));
+    }
+    return centers;
+}
+
+//Random walkers crowded around the tile corner at (2, 2) of 2 m tiles, some closer than the track distance
+static std::vector<std::vector<Eigen::Vector3f> > crowdAtCorner(unsigned int seed, int n, int frames)
+{
+    std::vector<Eigen::Vector3f> pos(n);
+    for(int i=0; i < n; i++)
+        pos[i] << 1.0f + 2.0f*rand_r(&seed)/RAND_MAX, 0.0f, 1.0f + 2.0f*rand_r(&seed)/RAND_MAX;
+    std::vector<std::vector<Eigen::Vector3f> > scene(frames);
+    for(int f=0; f < frames; f++)
+    {
+        for(int i=0; i < n; i++)
+        {
+            pos[i] += Eigen::Vector3f(0.2f*rand_r(&seed)/RAND_MAX - 0.1f, 0.0f, 0.2f*rand_r(&seed)/RAND_MAX - 0.1f);
+            if(rand_r(&seed) % 8 != 0)
+                scene[f].push_back(pos[i]);
+        }
+    }
+    return scene;
+}
+
+//Shards and PeopleTracker create tracks in a different order: compare by position
+static std::vector<person> sortedByPosition(std::vector<person> world)
+{
+    for(int i=0; i < world.size(); i++)
+        for(int j=i+1; j < world.size(); j++)
+            if((world[j].points(2) < world[i].points(2)) ||
+               ((world[j].points(2) == world[i].points(2)) && (world[j].points(0) < world[i].points(0))))
+                std::swap(world[i], world[j]);
+    return world;
+}
+
+static void expectSameTracks(const std::vector<person> &world_ref, const std::vector<person> &world, int frame)
+{
+    std::vector<person> a = sortedByPosition(world_ref), b = sortedByPosition(world);
+    ASSERT_EQ(a.size(), b.size()) << "frame " << frame;
+    for(int i=0; i < a.size(); i++)
+    {
+        EXPECT_TRUE(a[i].points == b[i].points) << "frame " << frame;
+        EXPECT_EQ(a[i].framesage, b[i].framesage) << "frame " << frame;
+        EXPECT_EQ(a[i].incount, b[i].incount) << "frame " << frame;
+        EXPECT_EQ(a[i].outcount, b[i].outcount) << "frame " << frame;
+        EXPECT_EQ(a[i].istrack, b[i].istrack) << "frame " << frame;
+    }
+}
+
+struct allocate_many{
+    TrackIdAllocator *allocator;
+    std::vector<int> *ids;
+    int n;
+    void operator()() { for(int i=0; i < n; i++) ids->push_back(allocator->allocate()); }
+};
+
+TEST(ShardedPeopleTrackerTest, TrackIdAllocatorIsUniqueAcrossThreads)
+{
+    TrackIdAllocator allocator;
+    const int per_thread = 10000;
+    std::vector<int> ids[4];
+    boost::thread_group threads;
+    for(int t=0; t < 4; t++)
+    {
+        allocate_many job = {&allocator, &ids[t], per_thread};
+        threads.create_thread(job);
+    }
+    threads.join_all();
+    std::set<int> all;
+    for(int t=0; t < 4; t++)
+        all.insert(ids[t].begin(), ids[t].end());
+    EXPECT_EQ(4u*per_thread, all.size());
+    EXPECT_EQ(FIRST_TRACK_ID, *all.begin());
+    EXPECT_EQ(FIRST_TRACK_ID + 4*per_thread, allocator.peek());
+}
+
+TEST(ShardedPeopleTrackerTest, KeepsIdsAcrossTileBoundaries)
+{
+    ShardedPeopleTracker tracker(4);
+    tracker.setTileSize(2.0);
+    tracker.setTrackThreshold(0.3);
+    std::vector<person> world;
+    for(int f=0; f < 120; f++)
+    {
+        tracker.setFrameStamp(0.1*f);
+        tracker.trackPeople(world, walkers(6, f), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+        ASSERT_EQ(6u, world.size()) << "frame " << f;
+    }
+    //Walked 12 m through 6 tiles: still the ids of the first frame
+    std::set<int> ids;
+    for(int i=0; i < world.size(); i++)
+        ids.insert(world[i].id);
+    EXPECT_EQ(6u, ids.size());
+    EXPECT_EQ(1, *ids.begin());
+    EXPECT_EQ(6, *ids.rbegin());
+    EXPECT_GT(tracker.getShardCount(), 1);
+}
+
+TEST(ShardedPeopleTrackerTest, MatchesPeopleTrackerForAnyThreadCount)
+{
+    PeopleTracker reference;
+    reference.setVerbose(false);
+    reference.setTrackThreshold(0.3);
+    ShardedPeopleTracker one(1), many(4);
+    one.setTileSize(2.0);
+    many.setTileSize(2.0);
+    std::vector<person> world_ref, world_one, world_many;
+    for(int f=0; f < 60; f++)
+    {
+        std::vector<Eigen::Vector3f> centers = walkers(5, f);
+        if(f % 7 == 3)
+            centers.erase(centers.begin() + (f % 5)); //missed detection
+        reference.setFrameStamp(0.1*f);
+        one.setFrameStamp(0.1*f);
+        many.setFrameStamp(0.1*f);
+        reference.trackPeople(world_ref, centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+        one.trackPeople(world_one, centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+        many.trackPeople(world_many, centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+    }
+    std::vector<person> a = sortedByPosition(world_ref), b = sortedByPosition(world_one), c = sortedByPosition(world_many);
+    ASSERT_EQ(a.size(), b.size());
+    ASSERT_EQ(a.size(), c.size());
+    for(int i=0; i < a.size(); i++)
+    {
+        EXPECT_TRUE(a[i].points.isApprox(b[i].points));
+        EXPECT_TRUE(a[i].points.isApprox(c[i].points));
+        EXPECT_EQ(a[i].framesage, c[i].framesage);
+        EXPECT_EQ(a[i].outcount, c[i].outcount);
+        EXPECT_EQ(a[i].istrack, c[i].istrack);
+    }
+}
+
+TEST(ShardedPeopleTrackerTest, TracksStraddlingATileEdge)
+{
+    //A (tile 0) and B (tile 1) 0.35 m apart across the edge at x = 2, both detections nearest to A:
+    //the global greedy match gives 1.92 to A and 2.05 to B
+    PeopleTracker reference;
+    reference.setVerbose(false);
+    reference.setTrackThreshold(0.3);
+    ShardedPeopleTracker tracker(4);
+    tracker.setTileSize(2.0);
+    tracker.setTrackThreshold(0.3);
+    std::vector<Eigen::Vector3f> frame0, frame1;
+    frame0.push_back(Eigen::Vector3f(1.9f, 0.0f, 1.0f));
+    frame0.push_back(Eigen::Vector3f(2.25f, 0.0f, 1.0f));
+    frame1.push_back(Eigen::Vector3f(1.92f, 0.0f, 1.0f));
+    frame1.push_back(Eigen::Vector3f(2.05f, 0.0f, 1.0f));
+    std::vector<person> world_ref, world;
+    reference.trackPeople(world_ref, frame0, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    tracker.trackPeople(world, frame0, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    EXPECT_EQ(2, tracker.getShardCount());
+    reference.setFrameStamp(0.1);
+    tracker.setFrameStamp(0.1);
+    reference.trackPeople(world_ref, frame1, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    tracker.trackPeople(world, frame1, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+
+    ASSERT_EQ(2u, world.size());
+    EXPECT_EQ(1, world[0].id);
+    EXPECT_TRUE(world[0].points == frame1[0]);
+    EXPECT_EQ(2, world[1].id);
+    EXPECT_TRUE(world[1].points == frame1[1]);
+    expectSameTracks(world_ref, world, 1);
+}
+
+TEST(ShardedPeopleTrackerTest, CrowdAtTileCornerMatchesPeopleTracker)
+{
+    std::vector<std::vector<Eigen::Vector3f> > scene = crowdAtCorner(11, 24, 80);
+    int methods[2] = {UPDATE_NORMAL, UPDATE_WITH_FRAME_COUNT};
+    for(int m=0; m < 2; m++)
+    {
+        PeopleTracker reference;
+        reference.setVerbose(false);
+        reference.setTrackThreshold(0.3);
+        ShardedPeopleTracker tracker(4);
+        tracker.setTileSize(2.0);
+        tracker.setTrackThreshold(0.3);
+        std::vector<person> world_ref, world;
+        for(int f=0; f < scene.size(); f++)
+        {
+            reference.setFrameStamp(0.1*f);
+            tracker.setFrameStamp(0.1*f);
+            reference.trackPeople(world_ref, scene[f], MULTI_NEAREST_NEIGHBOR_TRACKER, methods[m]);
+            tracker.trackPeople(world, scene[f], MULTI_NEAREST_NEIGHBOR_TRACKER, methods[m]);
+            expectSameTracks(world_ref, world, f);
+            if(HasFatalFailure())
+                return;
+        }
+    }
+}
+
+TEST(ShardedPeopleTrackerTest, SameIdsForAnyThreadCount)
+{
+    //Several tracks created in the same frame in different tiles: same ids in the same order
+    std::vector<person> world[2];
+    int threads[2] = {1, 4};
+    for(int t=0; t < 2; t++)
+    {
+        ShardedPeopleTracker tracker(threads[t]);
+        tracker.setTileSize(1.0);
+        for(int f=0; f < 40; f++)
+        {
+            std::vector<Eigen::Vector3f> centers = walkers(8, f);
+            if(f % 6 == 2)
+                centers.erase(centers.begin() + (f % 8));
+            tracker.setFrameStamp(0.1*f);
+            tracker.trackPeople(world[t], centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+        }
+    }
+    ASSERT_EQ(world[0].size(), world[1].size());
+    for(int i=0; i < world[0].size(); i++)
+    {
+        EXPECT_EQ(world[0][i].id, world[1][i].id);
+        EXPECT_GT(world[0][i].id, 0);
+        EXPECT_TRUE(world[0][i].points == world[1][i].points);
+    }
+}
+
+TEST(ShardedPeopleTrackerTest, HistoryOfMergedList)
+{
+    ShardedPeopleTracker tracker(2);
+    tracker.setTileSize(2.0);
+    std::vector<person> world;
+    for(int f=0; f < 30; f++)
+    {
+        tracker.setFrameStamp(0.1*f);
+        tracker.trackPeople(world, walkers(2, f), MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    }
+    std::vector<track_sample> samples;
+    ASSERT_EQ(2u, world.size());
+    ASSERT_TRUE(tracker.getTrackHistory().getTrack(world[0].id, 0.0, samples));
+    EXPECT_EQ(30u, samples.size());
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
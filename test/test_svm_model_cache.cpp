@@ -0,0 +1,104 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// SVMModelCache: round trip, and a cache is not used for another model than the one it was converted from.
+//
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+#include <SVMModelCache.h>
+
+
+static std::string tempPath(std::string name)
+{
+    std::stringstream ss;
+    ss << "/tmp/test_svm_model_cache_" << getpid() << "_" << name;
+    return ss.str();
+}
+
+static void writeFile(std::string filename, std::string content)
+{
+    FILE *file = fopen(filename.c_str(), "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+}
+
+static void setModel(pcl::people::PersonClassifier<pcl::RGB> &classifier, float first_weight)
+{
+    std::vector<float> weights(36*4, 0.25f);
+    weights[0] = first_weight;
+    classifier.setSVM(128, 64, weights, -1.5f);
+}
+
+class SVMModelCacheTest : public testing::Test
+{
+    protected:
+        virtual void SetUp()
+        {
+            this->source = tempPath("model.yaml");
+            this->cache = tempPath("model.bin");
+            writeFile(this->source, "SVM_weights: [0.5, 0.25]\nSVM_offset: -1.5\n");
+        }
+        virtual void TearDown()
+        {
+            remove(this->source.c_str());
+            remove(this->cache.c_str());
+        }
+        std::string source;
+        std::string cache;
+};
+
+TEST_F(SVMModelCacheTest, RoundTrip)
+{
+    pcl::people::PersonClassifier<pcl::RGB> classifier, loaded;
+    setModel(classifier, 0.5f);
+    ASSERT_TRUE(SVMModelCache::save(this->cache, classifier, this->source));
+    ASSERT_EQ(SVM_MODEL_CACHE_OK, SVMModelCache::load(this->cache, loaded, this->source));
+    EXPECT_EQ(classifier.getSVMWeights(), loaded.getSVMWeights());
+    EXPECT_EQ(classifier.getSVMOffset(), loaded.getSVMOffset());
+    EXPECT_EQ(128, loaded.getWindowHeight());
+    EXPECT_EQ(64, loaded.getWindowWidth());
+
+    //No source to compare with: the cache is used
+    remove(this->source.c_str());
+    EXPECT_EQ(SVM_MODEL_CACHE_OK, SVMModelCache::load(this->cache, loaded, this->source));
+}
+
+TEST_F(SVMModelCacheTest, StaleCacheIsNotLoaded)
+{
+    pcl::people::PersonClassifier<pcl::RGB> classifier, loaded;
+    setModel(classifier, 0.5f);
+    ASSERT_TRUE(SVMModelCache::save(this->cache, classifier, this->source));
+    setModel(loaded, 9.0f);
+
+    //Same size, different content
+    writeFile(this->source, "SVM_weights: [0.5, 0.75]\nSVM_offset: -1.5\n");
+    EXPECT_EQ(SVM_MODEL_CACHE_STALE, SVMModelCache::load(this->cache, loaded, this->source));
+    EXPECT_EQ(9.0f, loaded.getSVMWeights()[0]);
+
+    //Another model file
+    std::string other = tempPath("other.yaml");
+    writeFile(other, "SVM_weights: [1.0]\n");
+    EXPECT_EQ(SVM_MODEL_CACHE_STALE, SVMModelCache::load(this->cache, loaded, other));
+    remove(other.c_str());
+    EXPECT_EQ(9.0f, loaded.getSVMWeights()[0]);
+}
+
+TEST_F(SVMModelCacheTest, MissingAndInvalidCache)
+{
+    pcl::people::PersonClassifier<pcl::RGB> loaded;
+    EXPECT_EQ(SVM_MODEL_CACHE_MISSING, SVMModelCache::load(this->cache, loaded, this->source));
+    writeFile(this->cache, "not a cache");
+    EXPECT_EQ(SVM_MODEL_CACHE_INVALID, SVMModelCache::load(this->cache, loaded, this->source));
+    EXPECT_TRUE(loaded.getSVMWeights().empty());
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// SyntheticCrowd: every pixel whose ray hits a person's body gets a point on the person.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <SyntheticCrowd.h>
+
+
+static Eigen::Matrix3f kinectIntrinsics(void)
+{
+    Eigen::Matrix3f k;
+    k << 525.0f, 0.0f, 319.5f,
+         0.0f, 525.0f, 239.5f,
+         0.0f, 0.0f, 1.0f;
+    return k;
+}
+
+//Pixels of row v whose ray crosses the body cylinder of p (at position) and the points generated there
+static void expectRowOnPerson(const pcl::PointCloud<pcl::PointXYZRGBA> &cloud, const Eigen::Matrix3f &k, int v,
+                              const synthetic_person &p, const Eigen::Vector3f &position, int &hits)
+{
+    Eigen::Matrix3f inv = k.inverse();
+    hits = 0;
+    for(int u=0; u < cloud.width; u++)
+    {
+        Eigen::Vector3f ray = inv*Eigen::Vector3f(u, v, 1.0f);
+        float a = ray(0)*ray(0) + ray(2)*ray(2);
+        float b = -2.0f*(ray(0)*position(0) + ray(2)*position(2));
+        float c = position(0)*position(0) + position(2)*position(2) - p.radius*p.radius;
+        //Strictly inside the silhouette: grazing rays are left to rounding
+        if(b*b - 4.0f*a*c <= 1e-3f*a)
+            continue;
+        hits++;
+        const pcl::PointXYZRGBA &pt = cloud.points[v*cloud.width + u];
+        ASSERT_TRUE(std::isfinite(pt.z)) << "pixel " << u;
+        Eigen::Vector2f offset(pt.x - position(0), pt.z - position(2));
+        EXPECT_NEAR(p.radius, offset.norm(), 1e-3f) << "pixel " << u;
+    }
+}
+
+TEST(SyntheticCrowdTest, OffAxisPersonSilhouetteIsComplete)
+{
+    Eigen::Matrix3f k = kinectIntrinsics();
+    SyntheticCrowd crowd(k);
+    pcl::PointCloud<pcl::PointXYZRGBA> cloud;
+    std::vector<synthetic_ground_truth> ground_truth;
+
+    //Left and right of the optical axis, near and far
+    float xs[] = {2.0f, -2.0f, 0.8f, -0.6f};
+    float zs[] = {4.0f, 4.0f, 1.8f, 2.0f};
+    for(int n=0; n < 4; n++)
+    {
+        crowd.clear();
+        synthetic_person p;
+        p.id = 1;
+        p.height = 1.7f;
+        p.radius = 0.25f;
+        p.speed = 0.0f;
+        p.waypoints.push_back(Eigen::Vector3f(xs[n], 0.0f, zs[n]));
+        p.color << 200, 0, 0;
+        crowd.addPerson(p);
+        crowd.generate(0.0, cloud, ground_truth);
+        ASSERT_EQ(1u, ground_truth.size());
+
+        //Row through the middle of the body (0.5 m above the floor, camera 1 m high)
+        Eigen::Vector3f px = k*Eigen::Vector3f(xs[n], 0.5f, zs[n]);
+        int v = (int)lrintf(px(1)/px(2));
+        int hits;
+        expectRowOnPerson(cloud, k, v, p, p.waypoints[0], hits);
+        //Silhouette width: 2*asin(r/d) of the view angle
+        float d = sqrtf(xs[n]*xs[n] + zs[n]*zs[n]);
+        EXPECT_GT(hits, 0.8f*525.0f*(tanf(atan2f(xs[n], zs[n]) + asinf(p.radius/d)) -
+                                     tanf(atan2f(xs[n], zs[n]) - asinf(p.radius/d))));
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// BasicPeopleTracker specializations and the PeopleTracker front-end: same tracks as the pre-refactor tracker (golden
+// fixture), metrics and custom policies.
+//
+
+#include <gtest/gtest.h>
+#include <PeopleTracker.h>
+#include <BasicPeopleTracker.h>
+#include "tracker_golden_fixture.h"
+
+
+//Detections of the golden fixture, one list per frame
+static std::vector<std::vector<Eigen::Vector3f> > goldenScene(void)
+{
+    std::vector<std::vector<Eigen::Vector3f> > scene;
+    for(int i=0; i < sizeof(GOLDEN_DETECTIONS)/sizeof(GOLDEN_DETECTIONS[0]); i++)
+    {
+        const golden_detection &d = GOLDEN_DETECTIONS[i];
+        scene.resize(d.frame + 1);
+        scene[d.frame].push_back(Eigen::Vector3f(d.x, d.y, d.z));
+    }
+    return scene;
+}
+
+//Track list after frame against the pre-refactor tracker: bit-identical ids, points and counters
+static void expectGoldenFrame(const std::vector<person> &world, int algorithm, int method, int frame, const char *tracker)
+{
+    std::vector<golden_track> expected;
+    for(int i=0; i < sizeof(GOLDEN_TRACKS)/sizeof(GOLDEN_TRACKS[0]); i++)
+    {
+        const golden_track &t = GOLDEN_TRACKS[i];
+        if((t.algorithm == algorithm) && (t.list_update_method == method) && (t.frame == frame))
+            expected.push_back(t);
+    }
+    ASSERT_EQ(expected.size(), world.size()) << tracker << ", frame " << frame;
+    for(int i=0; i < world.size(); i++)
+    {
+        EXPECT_EQ(expected[i].id, world[i].id) << tracker << ", frame " << frame;
+        EXPECT_EQ(Eigen::Vector3f(expected[i].x, expected[i].y, expected[i].z), world[i].points) << tracker << ", frame " << frame;
+        EXPECT_EQ(expected[i].framesage, world[i].framesage) << tracker << ", frame " << frame;
+        EXPECT_EQ(expected[i].incount, world[i].incount) << tracker << ", frame " << frame;
+        EXPECT_EQ(expected[i].outcount, world[i].outcount) << tracker << ", frame " << frame;
+        EXPECT_EQ(expected[i].istrack != 0, world[i].istrack) << tracker << ", frame " << frame;
+    }
+}
+
+//Both the front-end and the specialization against the golden fixture
+template<class Tracker>
+static void expectGolden(Tracker &specialized, int algorithm, int method)
+{
+    PeopleTracker front_end;
+    front_end.setVerbose(false);
+    std::vector<std::vector<Eigen::Vector3f> > scene = goldenScene();
+    ASSERT_EQ(30u, scene.size());
+    std::vector<person> world_a, world_b;
+    for(int f=0; f < scene.size(); f++)
+    {
+        front_end.setFrameStamp(0.1*f);
+        specialized.setFrameStamp(0.1*f);
+        front_end.trackPeople(world_a, scene[f], algorithm, method);
+        specialized.trackPeople(world_b, scene[f]);
+        expectGoldenFrame(world_a, algorithm, method, f, "front-end");
+        expectGoldenFrame(world_b, algorithm, method, f, "specialized");
+    }
+}
+
+TEST(TrackerPoliciesTest, MultiNNFrameCountMatchesGolden)
+{
+    BasicPeopleTracker<MultiNNAssociation, FrameCountLifecycle> tracker;
+    expectGolden(tracker, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+}
+
+TEST(TrackerPoliciesTest, MultiNNNormalMatchesGolden)
+{
+    BasicPeopleTracker<MultiNNAssociation, NormalLifecycle> tracker;
+    expectGolden(tracker, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+}
+
+TEST(TrackerPoliciesTest, SingleNNFrameCountMatchesGolden)
+{
+    BasicPeopleTracker<SingleNNAssociation, FrameCountLifecycle> tracker;
+    expectGolden(tracker, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_WITH_FRAME_COUNT);
+}
+
+TEST(TrackerPoliciesTest, SingleNNNormalMatchesGolden)
+{
+    BasicPeopleTracker<SingleNNAssociation, NormalLifecycle> tracker;
+    expectGolden(tracker, SINGLE_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+}
+
+TEST(TrackerPoliciesTest, GroundPlaneDistanceIgnoresHeight)
+{
+    Eigen::Vector3f a(1.0f, 0.0f, 2.0f), b(1.0f, 0.5f, 2.1f);
+    EXPECT_NEAR(0.1f, GroundPlaneDistance::distance(a, b), 1e-5);
+    EXPECT_NEAR(sqrt(0.26f), EuclideanDistance::distance(a, b), 1e-5);
+
+    //A person crouching (center drops 0.5 m) keeps the track with the ground plane metric only
+    std::vector<Eigen::Vector3f> frame0(1, a), frame1(1, b);
+    PeopleTracker tracker;
+    tracker.setVerbose(false);
+    tracker.setDistanceMetric(DISTANCE_GROUND_PLANE);
+    std::vector<person> world;
+    tracker.trackPeople(world, frame0, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    tracker.trackPeople(world, frame1, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(1u, world.size());
+    EXPECT_EQ(1, world[0].id);
+
+    tracker.setDistanceMetric(DISTANCE_EUCLIDEAN);
+    tracker.trackPeople(world, frame0, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    ASSERT_EQ(1u, world.size());
+    EXPECT_EQ(2, world[0].id);
+}
+
+//Policies outside TrackerPolicies.h plug in without the front-end
+struct ManhattanDistance
+{
+    static float distance(const Eigen::Vector3f &A, const Eigen::Vector3f &B)
+    {
+        return (A - B).cwiseAbs().sum();
+    }
+};
+
+TEST(TrackerPoliciesTest, CustomMetric)
+{
+    BasicPeopleTracker<MultiNNAssociation, NormalLifecycle, ManhattanDistance> tracker;
+    tracker.setTrackThreshold(0.3);
+    std::vector<person> world;
+    std::vector<Eigen::Vector3f> centers(1, Eigen::Vector3f(1.0f, 0.0f, 2.0f));
+    tracker.trackPeople(world, centers);
+    //Euclidean 0.28, Manhattan 0.4: a new person
+    centers[0] += Eigen::Vector3f(0.2f, 0.0f, 0.2f);
+    tracker.trackPeople(world, centers);
+    ASSERT_EQ(1u, world.size());
+    EXPECT_EQ(2, world[0].id);
+}
+
+TEST(TrackerPoliciesTest, UnknownCombinationLeavesListUntouched)
+{
+    PeopleTracker tracker;
+    tracker.setVerbose(false);
+    std::vector<person> world;
+    std::vector<Eigen::Vector3f> centers(1, Eigen::Vector3f(1.0f, 0.0f, 1.0f));
+    tracker.trackPeople(world, centers, KALMAN_TRACKER, UPDATE_NORMAL);
+    EXPECT_TRUE(world.empty());
+    tracker.trackPeople(world, centers, MULTI_NEAREST_NEIGHBOR_TRACKER, UPDATE_NORMAL);
+    EXPECT_EQ(1u, world.size());
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// VoxelDownsampler: same voxels as the serial CompactCloudFilter::voxelDownsample for any thread count.
+//
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <VoxelDownsampler.h>
+
+
+//Row major scan of a noisy scene in front of the camera, like an organized depth cloud
+static std::vector<compact_point> randomCloud(unsigned int seed, int n)
+{
+    std::vector<compact_point> cloud(n);
+    for(int i=0; i < n; i++)
+    {
+        compact_point &p = cloud[i];
+        float u = (float)(i % 640)/640.0f;
+        float v = (float)(i/640)/480.0f;
+        p.x = CompactCloud::toMillimeter(-2.0f + 4.0f*u + 0.01f*rand_r(&seed)/RAND_MAX);
+        p.y = CompactCloud::toMillimeter(-1.5f + 3.0f*v + 0.01f*rand_r(&seed)/RAND_MAX);
+        p.z = CompactCloud::toMillimeter(1.0f + 3.0f*rand_r(&seed)/RAND_MAX);
+        p.r = rand_r(&seed) % 256;
+        p.g = rand_r(&seed) % 256;
+        p.b = rand_r(&seed) % 256;
+        p.reserved = 0;
+    }
+    return cloud;
+}
+
+static void expectSamePoints(const std::vector<compact_point> &a, const std::vector<compact_point> &b)
+{
+    ASSERT_EQ(a.size(), b.size());
+    for(int i=0; i < a.size(); i++)
+    {
+        EXPECT_EQ(a[i].x, b[i].x) << "voxel " << i;
+        EXPECT_EQ(a[i].y, b[i].y) << "voxel " << i;
+        EXPECT_EQ(a[i].z, b[i].z) << "voxel " << i;
+        EXPECT_EQ(a[i].r, b[i].r) << "voxel " << i;
+        EXPECT_EQ(a[i].g, b[i].g) << "voxel " << i;
+        EXPECT_EQ(a[i].b, b[i].b) << "voxel " << i;
+    }
+}
+
+TEST(VoxelDownsamplerTest, MatchesSerialFilter)
+{
+    CompactCloudFilter filter;
+    std::vector<compact_point> expected, out;
+    for(int threads=1; threads <= 4; threads++)
+    {
+        VoxelDownsampler downsampler(threads);
+        EXPECT_EQ(threads, downsampler.getThreadCount());
+        for(unsigned int seed=1; seed <= 3; seed++)
+        {
+            //Small cloud (one chunk) and a full frame (one chunk per thread)
+            int sizes[] = {1000, 640*480};
+            for(int s=0; s < 2; s++)
+            {
+                std::vector<compact_point> cloud = randomCloud(seed, sizes[s]);
+                filter.voxelDownsample(cloud, 0.06f, expected);
+                downsampler.downsample(cloud, 0.06f, out);
+                expectSamePoints(expected, out);
+            }
+        }
+    }
+}
+
+TEST(VoxelDownsamplerTest, VoxelAcrossChunksIsMerged)
+{
+    //Every point in one voxel: each chunk holds a partial sum of it
+    std::vector<compact_point> cloud(4*DEFAULT_VOXEL_MIN_CHUNK);
+    for(int i=0; i < cloud.size(); i++)
+    {
+        cloud[i].x = i % 32;
+        cloud[i].y = -(i % 16) - 1;
+        cloud[i].z = 1000;
+        cloud[i].r = i % 2 ? 10 : 20;
+        cloud[i].g = 0;
+        cloud[i].b = 255;
+        cloud[i].reserved = 0;
+    }
+    VoxelDownsampler downsampler(4);
+    std::vector<compact_point> out;
+    downsampler.downsample(cloud, 0.06f, out);
+    ASSERT_EQ(1u, out.size());
+    EXPECT_EQ(16, out[0].x); //15.5 and -8.5 rounded to even as lrint
+    EXPECT_EQ(-8, out[0].y);
+    EXPECT_EQ(1000, out[0].z);
+    EXPECT_EQ(15, out[0].r);
+    EXPECT_EQ(255, out[0].b);
+}
+
+TEST(VoxelDownsamplerTest, TablesGrowAndReset)
+{
+    //More voxels than the initial table, then a smaller frame: nothing left over from the previous one
+    VoxelDownsampler downsampler(1);
+    CompactCloudFilter filter;
+    std::vector<compact_point> big, expected, out;
+    for(int i=0; i < 4*DEFAULT_VOXEL_TABLE_SIZE; i++)
+    {
+        compact_point p;
+        p.x = (i % 100)*60;
+        p.y = (i/100)*60 - 3000;
+        p.z = 2000;
+        p.r = p.g = p.b = 1;
+        p.reserved = 0;
+        big.push_back(p);
+    }
+    downsampler.downsample(big, 0.06f, out);
+    filter.voxelDownsample(big, 0.06f, expected);
+    expectSamePoints(expected, out);
+
+    std::vector<compact_point> small(big.begin(), big.begin() + 10);
+    downsampler.downsample(small, 0.06f, out);
+    EXPECT_EQ(10u, out.size());
+
+    downsampler.downsample(std::vector<compact_point>(), 0.06f, out);
+    EXPECT_TRUE(out.empty());
+}
+
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
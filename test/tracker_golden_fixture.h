@@ -0,0 +1,472 @@
+//
+// Created by kandithws on 7/1/2559.
+//
+// Golden output of the tracker before the policy split (PeopleTracker, commit 7e16bb8^): randomScene(7, 4, 30) of
+// test_tracker_policies, frame f stamped 0.1*f, every algorithm/list update combination run on its own tracker.
+// Regenerate only for an intended change of the tracking results.
+//
+
+#ifndef PEOPLE_DETECTION_TRACKER_GOLDEN_FIXTURE_H
+#define PEOPLE_DETECTION_TRACKER_GOLDEN_FIXTURE_H
+
+typedef struct{
+    int frame;
+    float x, y, z;
+}golden_detection;
+
+typedef struct{
+    int algorithm;
+    int list_update_method;
+    int frame;
+    int id;
+    float x, y, z;
+    int framesage;
+    int incount;
+    int outcount;
+    int istrack;
+}golden_track;
+
+//Detections of every frame, in input order
+static const golden_detection GOLDEN_DETECTIONS[] = {
+    {0, 2.1949718f, 0.0143328933f, 3.56328583f},
+    {0, 0.662470102f, 0.0701450631f, 1.11251414f},
+    {0, 3.3025825f, 0.0385456569f, 1.52823162f},
+    {0, 2.73148298f, 0.132264882f, 1.16577518f},
+    {0, 2.75809717f, 0.0f, 2.1747036f},
+    {1, 2.17787957f, 0.0143328933f, 3.56007624f},
+    {1, 0.69436866f, 0.0701450631f, 1.15479219f},
+    {1, 3.31296253f, 0.0385456569f, 1.51866579f},
+    {1, 2.74794102f, 0.132264882f, 1.14484799f},
+    {2, 2.16078734f, 0.0143328933f, 3.55686665f},
+    {2, 3.32334256f, 0.0385456569f, 1.50909996f},
+    {2, 2.76439905f, 0.132264882f, 1.1239208f},
+    {3, 2.14369512f, 0.0143328933f, 3.55365705f},
+    {3, 0.758165777f, 0.0701450631f, 1.23934829f},
+    {3, 3.33372259f, 0.0385456569f, 1.49953413f},
+    {3, 2.78085709f, 0.132264882f, 1.10299361f},
+    {4, 2.12660289f, 0.0143328933f, 3.55044746f},
+    {4, 0.790064335f, 0.0701450631f, 1.28162634f},
+    {4, 3.34410262f, 0.0385456569f, 1.4899683f},
+    {4, 2.79731512f, 0.132264882f, 1.08206642f},
+    {5, 2.10951066f, 0.0143328933f, 3.54723787f},
+    {5, 0.821962893f, 0.0701450631f, 1.3239044f},
+    {5, 3.35448265f, 0.0385456569f, 1.48040247f},
+    {5, 2.81377316f, 0.132264882f, 1.06113923f},
+    {6, 2.09241843f, 0.0143328933f, 3.54402828f},
+    {6, 0.853861451f, 0.0701450631f, 1.36618245f},
+    {6, 3.36486268f, 0.0385456569f, 1.47083664f},
+    {6, 2.83023119f, 0.132264882f, 1.04021204f},
+    {7, 2.0753262f, 0.0143328933f, 3.54081869f},
+    {7, 0.885760009f, 0.0701450631f, 1.4084605f},
+    {7, 3.37524271f, 0.0385456569f, 1.46127081f},
+    {7, 2.84668922f, 0.132264882f, 1.01928484f},
+    {7, 0.930588424f, 0.0f, 4.08343077f},
+    {8, 2.05823398f, 0.0143328933f, 3.5376091f},
+    {8, 0.917658567f, 0.0701450631f, 1.45073855f},
+    {8, 3.38562274f, 0.0385456569f, 1.45170498f},
+    {9, 2.04114175f, 0.0143328933f, 3.53439951f},
+    {9, 3.39600277f, 0.0385456569f, 1.44213915f},
+    {10, 2.02404952f, 0.0143328933f, 3.53118992f},
+    {10, 0.981455684f, 0.0701450631f, 1.53529465f},
+    {10, 3.4063828f, 0.0385456569f, 1.43257332f},
+    {10, 2.89606333f, 0.132264882f, 0.956503272f},
+    {11, 2.00695729f, 0.0143328933f, 3.52798033f},
+    {11, 1.01335418f, 0.0701450631f, 1.5775727f},
+    {11, 3.41676283f, 0.0385456569f, 1.42300749f},
+    {11, 2.91252136f, 0.132264882f, 0.935576081f},
+    {12, 1.98986506f, 0.0143328933f, 3.52477074f},
+    {12, 3.42714286f, 0.0385456569f, 1.41344166f},
+    {12, 2.9289794f, 0.132264882f, 0.91464889f},
+    {13, 1.97277284f, 0.0143328933f, 3.52156115f},
+    {13, 3.43752289f, 0.0385456569f, 1.40387583f},
+    {13, 2.94543743f, 0.132264882f, 0.8937217f},
+    {14, 1.95568061f, 0.0143328933f, 3.51835155f},
+    {14, 1.10904968f, 0.0701450631f, 1.70440686f},
+    {14, 3.44790292f, 0.0385456569f, 1.39431f},
+    {14, 2.96189547f, 0.132264882f, 0.872794509f},
+    {15, 1.93858838f, 0.0143328933f, 3.51514196f},
+    {15, 1.14094818f, 0.0701450631f, 1.74668491f},
+    {15, 3.45828295f, 0.0385456569f, 1.38474417f},
+    {15, 2.9783535f, 0.132264882f, 0.851867318f},
+    {16, 1.92149615f, 0.0143328933f, 3.51193237f},
+    {16, 1.17284667f, 0.0701450631f, 1.78896296f},
+    {16, 3.46866298f, 0.0385456569f, 1.37517834f},
+    {16, 2.99481153f, 0.132264882f, 0.830940127f},
+    {16, 1.57784665f, 0.0f, 4.71801949f},
+    {17, 1.90440392f, 0.0143328933f, 3.50872278f},
+    {17, 1.20474517f, 0.0701450631f, 1.83124101f},
+    {17, 3.47904301f, 0.0385456569f, 1.36561251f},
+    {17, 3.01126957f, 0.132264882f, 0.810012937f},
+    {18, 1.23664367f, 0.0701450631f, 1.87351906f},
+    {18, 3.48942304f, 0.0385456569f, 1.35604668f},
+    {18, 3.0277276f, 0.132264882f, 0.789085746f},
+    {19, 1.87021947f, 0.0143328933f, 3.5023036f},
+    {19, 1.26854217f, 0.0701450631f, 1.91579711f},
+    {19, 3.49980307f, 0.0385456569f, 1.34648085f},
+    {19, 3.04418564f, 0.132264882f, 0.768158555f},
+    {20, 1.85312724f, 0.0143328933f, 3.49909401f},
+    {20, 1.30044067f, 0.0701450631f, 1.95807517f},
+    {20, 3.5101831f, 0.0385456569f, 1.33691502f},
+    {20, 3.06064367f, 0.132264882f, 0.747231364f},
+    {21, 1.83603501f, 0.0143328933f, 3.49588442f},
+    {21, 3.52056313f, 0.0385456569f, 1.32734919f},
+    {21, 3.07710171f, 0.132264882f, 0.726304173f},
+    {21, 1.08876812f, 0.0f, 3.58960724f},
+    {22, 1.81894279f, 0.0143328933f, 3.49267483f},
+    {22, 1.36423767f, 0.0701450631f, 2.04263115f},
+    {22, 3.53094316f, 0.0385456569f, 1.31778336f},
+    {22, 3.09355974f, 0.132264882f, 0.705376983f},
+    {22, 1.24789011f, 0.0f, 1.07514071f},
+    {23, 1.80185056f, 0.0143328933f, 3.48946524f},
+    {23, 1.39613616f, 0.0701450631f, 2.0849092f},
+    {23, 3.54132318f, 0.0385456569f, 1.30821753f},
+    {23, 3.11001778f, 0.132264882f, 0.684449792f},
+    {23, 1.9527905f, 0.0f, 4.50398731f},
+    {24, 1.78475833f, 0.0143328933f, 3.48625565f},
+    {24, 1.42803466f, 0.0701450631f, 2.12718725f},
+    {24, 3.55170321f, 0.0385456569f, 1.2986517f},
+    {24, 3.12647581f, 0.132264882f, 0.663522601f},
+    {25, 1.7676661f, 0.0143328933f, 3.48304605f},
+    {25, 1.45993316f, 0.0701450631f, 2.1694653f},
+    {25, 3.56208324f, 0.0385456569f, 1.28908587f},
+    {25, 3.14293385f, 0.132264882f, 0.64259541f},
+    {26, 1.49183166f, 0.0701450631f, 2.21174335f},
+    {26, 3.57246327f, 0.0385456569f, 1.27952003f},
+    {26, 3.15939188f, 0.132264882f, 0.62166822f},
+    {26, 3.20687389f, 0.0f, 2.83304334f},
+    {27, 1.73348165f, 0.0143328933f, 3.47662687f},
+    {27, 1.52373016f, 0.0701450631f, 2.25402141f},
+    {27, 3.5828433f, 0.0385456569f, 1.2699542f},
+    {27, 3.17584991f, 0.132264882f, 0.600741029f},
+    {27, 3.77488565f, 0.0f, 3.64326859f},
+    {28, 1.71638942f, 0.0143328933f, 3.47341728f},
+    {28, 1.55562866f, 0.0701450631f, 2.29629946f},
+    {28, 3.59322333f, 0.0385456569f, 1.26038837f},
+    {28, 3.19230795f, 0.132264882f, 0.579813838f},
+    {28, 2.52302384f, 0.0f, 3.58379054f},
+    {29, 1.69929719f, 0.0143328933f, 3.47020769f},
+    {29, 1.58752716f, 0.0701450631f, 2.33857751f},
+    {29, 3.60360336f, 0.0385456569f, 1.25082254f},
+    {29, 3.20876598f, 0.132264882f, 0.558886647f}
+};
+
+//Track list after every frame, in list order
+static const golden_track GOLDEN_TRACKS[] = {
+    {0, 0, 0, 1, 0.662470102f, 0.0701450631f, 1.11251414f, 0, 2, 5, 1},
+    {0, 0, 1, 1, 0.69436866f, 0.0701450631f, 1.15479219f, 0, 2, 5, 1},
+    {0, 0, 3, 1, 0.758165777f, 0.0701450631f, 1.23934829f, 0, 2, 5, 1},
+    {0, 0, 4, 1, 0.790064335f, 0.0701450631f, 1.28162634f, 0, 2, 5, 1},
+    {0, 0, 5, 1, 0.821962893f, 0.0701450631f, 1.3239044f, 0, 2, 5, 1},
+    {0, 0, 6, 1, 0.853861451f, 0.0701450631f, 1.36618245f, 0, 2, 5, 1},
+    {0, 0, 7, 1, 0.885760009f, 0.0701450631f, 1.4084605f, 0, 2, 5, 1},
+    {0, 0, 8, 1, 0.917658567f, 0.0701450631f, 1.45073855f, 0, 2, 5, 1},
+    {0, 0, 10, 1, 0.981455684f, 0.0701450631f, 1.53529465f, 0, 2, 5, 1},
+    {0, 0, 11, 1, 1.01335418f, 0.0701450631f, 1.5775727f, 0, 2, 5, 1},
+    {0, 0, 14, 1, 1.10904968f, 0.0701450631f, 1.70440686f, 0, 2, 5, 1},
+    {0, 0, 15, 1, 1.14094818f, 0.0701450631f, 1.74668491f, 0, 2, 5, 1},
+    {0, 0, 16, 1, 1.17284667f, 0.0701450631f, 1.78896296f, 0, 2, 5, 1},
+    {0, 0, 17, 1, 1.20474517f, 0.0701450631f, 1.83124101f, 0, 2, 5, 1},
+    {0, 0, 18, 1, 1.23664367f, 0.0701450631f, 1.87351906f, 0, 2, 5, 1},
+    {0, 0, 19, 1, 1.26854217f, 0.0701450631f, 1.91579711f, 0, 2, 5, 1},
+    {0, 0, 20, 1, 1.30044067f, 0.0701450631f, 1.95807517f, 0, 2, 5, 1},
+    {0, 0, 22, 1, 1.24789011f, 0.0f, 1.07514071f, 0, 2, 5, 1},
+    {0, 1, 0, 1, 0.662470102f, 0.0701450631f, 1.11251414f, 1, 2, 5, 0},
+    {0, 1, 1, 1, 0.69436866f, 0.0701450631f, 1.15479219f, 2, 2, 5, 0},
+    {0, 1, 2, 1, 0.69436866f, 0.0701450631f, 1.15479219f, 3, 1, 5, 0},
+    {0, 1, 3, 1, 0.758165777f, 0.0701450631f, 1.23934829f, 3, 1, 5, 1},
+    {0, 1, 4, 1, 0.790064335f, 0.0701450631f, 1.28162634f, 4, 1, 5, 1},
+    {0, 1, 5, 1, 0.821962893f, 0.0701450631f, 1.3239044f, 5, 1, 5, 1},
+    {0, 1, 6, 1, 0.853861451f, 0.0701450631f, 1.36618245f, 6, 1, 5, 1},
+    {0, 1, 7, 1, 0.885760009f, 0.0701450631f, 1.4084605f, 7, 1, 5, 1},
+    {0, 1, 8, 1, 0.917658567f, 0.0701450631f, 1.45073855f, 8, 1, 5, 1},
+    {0, 1, 9, 1, 0.917658567f, 0.0701450631f, 1.45073855f, 9, 1, 4, 1},
+    {0, 1, 10, 1, 0.981455684f, 0.0701450631f, 1.53529465f, 10, 1, 4, 1},
+    {0, 1, 11, 1, 1.01335418f, 0.0701450631f, 1.5775727f, 11, 1, 4, 1},
+    {0, 1, 12, 1, 1.01335418f, 0.0701450631f, 1.5775727f, 12, 1, 3, 1},
+    {0, 1, 13, 1, 1.01335418f, 0.0701450631f, 1.5775727f, 13, 1, 2, 1},
+    {0, 1, 14, 1, 1.10904968f, 0.0701450631f, 1.70440686f, 14, 1, 2, 1},
+    {0, 1, 15, 1, 1.14094818f, 0.0701450631f, 1.74668491f, 15, 1, 2, 1},
+    {0, 1, 16, 1, 1.17284667f, 0.0701450631f, 1.78896296f, 16, 1, 2, 1},
+    {0, 1, 17, 1, 1.20474517f, 0.0701450631f, 1.83124101f, 17, 1, 2, 1},
+    {0, 1, 18, 1, 1.23664367f, 0.0701450631f, 1.87351906f, 18, 1, 2, 1},
+    {0, 1, 19, 1, 1.26854217f, 0.0701450631f, 1.91579711f, 19, 1, 2, 1},
+    {0, 1, 20, 1, 1.30044067f, 0.0701450631f, 1.95807517f, 20, 1, 2, 1},
+    {0, 1, 21, 1, 1.30044067f, 0.0701450631f, 1.95807517f, 21, 1, 1, 1},
+    {0, 1, 22, 1, 1.36423767f, 0.0701450631f, 2.04263115f, 22, 1, 1, 1},
+    {0, 1, 23, 1, 1.39613616f, 0.0701450631f, 2.0849092f, 23, 1, 1, 1},
+    {0, 1, 24, 1, 1.42803466f, 0.0701450631f, 2.12718725f, 24, 1, 1, 1},
+    {0, 1, 25, 1, 1.45993316f, 0.0701450631f, 2.1694653f, 25, 1, 1, 1},
+    {0, 1, 26, 1, 1.49183166f, 0.0701450631f, 2.21174335f, 26, 1, 1, 1},
+    {0, 1, 27, 1, 1.52373016f, 0.0701450631f, 2.25402141f, 27, 1, 1, 1},
+    {0, 1, 28, 1, 1.55562866f, 0.0701450631f, 2.29629946f, 28, 1, 1, 1},
+    {0, 1, 29, 1, 1.58752716f, 0.0701450631f, 2.33857751f, 29, 1, 1, 1},
+    {1, 0, 0, 1, 2.1949718f, 0.0143328933f, 3.56328583f, 0, 2, 5, 1},
+    {1, 0, 0, 2, 0.662470102f, 0.0701450631f, 1.11251414f, 0, 2, 5, 1},
+    {1, 0, 0, 3, 3.3025825f, 0.0385456569f, 1.52823162f, 0, 2, 5, 1},
+    {1, 0, 0, 4, 2.73148298f, 0.132264882f, 1.16577518f, 0, 2, 5, 1},
+    {1, 0, 0, 5, 2.75809717f, 0.0f, 2.1747036f, 0, 2, 5, 1},
+    {1, 0, 1, 1, 2.17787957f, 0.0143328933f, 3.56007624f, 0, 2, 5, 1},
+    {1, 0, 1, 2, 0.69436866f, 0.0701450631f, 1.15479219f, 0, 2, 5, 1},
+    {1, 0, 1, 3, 3.31296253f, 0.0385456569f, 1.51866579f, 0, 2, 5, 1},
+    {1, 0, 1, 4, 2.74794102f, 0.132264882f, 1.14484799f, 0, 2, 5, 1},
+    {1, 0, 2, 1, 2.16078734f, 0.0143328933f, 3.55686665f, 0, 2, 5, 1},
+    {1, 0, 2, 3, 3.32334256f, 0.0385456569f, 1.50909996f, 0, 2, 5, 1},
+    {1, 0, 2, 4, 2.76439905f, 0.132264882f, 1.1239208f, 0, 2, 5, 1},
+    {1, 0, 3, 1, 2.14369512f, 0.0143328933f, 3.55365705f, 0, 2, 5, 1},
+    {1, 0, 3, 3, 3.33372259f, 0.0385456569f, 1.49953413f, 0, 2, 5, 1},
+    {1, 0, 3, 4, 2.78085709f, 0.132264882f, 1.10299361f, 0, 2, 5, 1},
+    {1, 0, 3, 6, 0.758165777f, 0.0701450631f, 1.23934829f, 0, 2, 5, 1},
+    {1, 0, 4, 1, 2.12660289f, 0.0143328933f, 3.55044746f, 0, 2, 5, 1},
+    {1, 0, 4, 3, 3.34410262f, 0.0385456569f, 1.4899683f, 0, 2, 5, 1},
+    {1, 0, 4, 4, 2.79731512f, 0.132264882f, 1.08206642f, 0, 2, 5, 1},
+    {1, 0, 4, 6, 0.790064335f, 0.0701450631f, 1.28162634f, 0, 2, 5, 1},
+    {1, 0, 5, 1, 2.10951066f, 0.0143328933f, 3.54723787f, 0, 2, 5, 1},
+    {1, 0, 5, 3, 3.35448265f, 0.0385456569f, 1.48040247f, 0, 2, 5, 1},
+    {1, 0, 5, 4, 2.81377316f, 0.132264882f, 1.06113923f, 0, 2, 5, 1},
+    {1, 0, 5, 6, 0.821962893f, 0.0701450631f, 1.3239044f, 0, 2, 5, 1},
+    {1, 0, 6, 1, 2.09241843f, 0.0143328933f, 3.54402828f, 0, 2, 5, 1},
+    {1, 0, 6, 3, 3.36486268f, 0.0385456569f, 1.47083664f, 0, 2, 5, 1},
+    {1, 0, 6, 4, 2.83023119f, 0.132264882f, 1.04021204f, 0, 2, 5, 1},
+    {1, 0, 6, 6, 0.853861451f, 0.0701450631f, 1.36618245f, 0, 2, 5, 1},
+    {1, 0, 7, 1, 2.0753262f, 0.0143328933f, 3.54081869f, 0, 2, 5, 1},
+    {1, 0, 7, 3, 3.37524271f, 0.0385456569f, 1.46127081f, 0, 2, 5, 1},
+    {1, 0, 7, 4, 2.84668922f, 0.132264882f, 1.01928484f, 0, 2, 5, 1},
+    {1, 0, 7, 6, 0.885760009f, 0.0701450631f, 1.4084605f, 0, 2, 5, 1},
+    {1, 0, 7, 7, 0.930588424f, 0.0f, 4.08343077f, 0, 2, 5, 1},
+    {1, 0, 8, 1, 2.05823398f, 0.0143328933f, 3.5376091f, 0, 2, 5, 1},
+    {1, 0, 8, 3, 3.38562274f, 0.0385456569f, 1.45170498f, 0, 2, 5, 1},
+    {1, 0, 8, 6, 0.917658567f, 0.0701450631f, 1.45073855f, 0, 2, 5, 1},
+    {1, 0, 9, 1, 2.04114175f, 0.0143328933f, 3.53439951f, 0, 2, 5, 1},
+    {1, 0, 9, 3, 3.39600277f, 0.0385456569f, 1.44213915f, 0, 2, 5, 1},
+    {1, 0, 10, 1, 2.02404952f, 0.0143328933f, 3.53118992f, 0, 2, 5, 1},
+    {1, 0, 10, 3, 3.4063828f, 0.0385456569f, 1.43257332f, 0, 2, 5, 1},
+    {1, 0, 10, 8, 0.981455684f, 0.0701450631f, 1.53529465f, 0, 2, 5, 1},
+    {1, 0, 10, 9, 2.89606333f, 0.132264882f, 0.956503272f, 0, 2, 5, 1},
+    {1, 0, 11, 1, 2.00695729f, 0.0143328933f, 3.52798033f, 0, 2, 5, 1},
+    {1, 0, 11, 3, 3.41676283f, 0.0385456569f, 1.42300749f, 0, 2, 5, 1},
+    {1, 0, 11, 8, 1.01335418f, 0.0701450631f, 1.5775727f, 0, 2, 5, 1},
+    {1, 0, 11, 9, 2.91252136f, 0.132264882f, 0.935576081f, 0, 2, 5, 1},
+    {1, 0, 12, 1, 1.98986506f, 0.0143328933f, 3.52477074f, 0, 2, 5, 1},
+    {1, 0, 12, 3, 3.42714286f, 0.0385456569f, 1.41344166f, 0, 2, 5, 1},
+    {1, 0, 12, 9, 2.9289794f, 0.132264882f, 0.91464889f, 0, 2, 5, 1},
+    {1, 0, 13, 1, 1.97277284f, 0.0143328933f, 3.52156115f, 0, 2, 5, 1},
+    {1, 0, 13, 3, 3.43752289f, 0.0385456569f, 1.40387583f, 0, 2, 5, 1},
+    {1, 0, 13, 9, 2.94543743f, 0.132264882f, 0.8937217f, 0, 2, 5, 1},
+    {1, 0, 14, 1, 1.95568061f, 0.0143328933f, 3.51835155f, 0, 2, 5, 1},
+    {1, 0, 14, 3, 3.44790292f, 0.0385456569f, 1.39431f, 0, 2, 5, 1},
+    {1, 0, 14, 9, 2.96189547f, 0.132264882f, 0.872794509f, 0, 2, 5, 1},
+    {1, 0, 14, 10, 1.10904968f, 0.0701450631f, 1.70440686f, 0, 2, 5, 1},
+    {1, 0, 15, 1, 1.93858838f, 0.0143328933f, 3.51514196f, 0, 2, 5, 1},
+    {1, 0, 15, 3, 3.45828295f, 0.0385456569f, 1.38474417f, 0, 2, 5, 1},
+    {1, 0, 15, 9, 2.9783535f, 0.132264882f, 0.851867318f, 0, 2, 5, 1},
+    {1, 0, 15, 10, 1.14094818f, 0.0701450631f, 1.74668491f, 0, 2, 5, 1},
+    {1, 0, 16, 1, 1.92149615f, 0.0143328933f, 3.51193237f, 0, 2, 5, 1},
+    {1, 0, 16, 3, 3.46866298f, 0.0385456569f, 1.37517834f, 0, 2, 5, 1},
+    {1, 0, 16, 9, 2.99481153f, 0.132264882f, 0.830940127f, 0, 2, 5, 1},
+    {1, 0, 16, 10, 1.17284667f, 0.0701450631f, 1.78896296f, 0, 2, 5, 1},
+    {1, 0, 16, 11, 1.57784665f, 0.0f, 4.71801949f, 0, 2, 5, 1},
+    {1, 0, 17, 1, 1.90440392f, 0.0143328933f, 3.50872278f, 0, 2, 5, 1},
+    {1, 0, 17, 3, 3.47904301f, 0.0385456569f, 1.36561251f, 0, 2, 5, 1},
+    {1, 0, 17, 9, 3.01126957f, 0.132264882f, 0.810012937f, 0, 2, 5, 1},
+    {1, 0, 17, 10, 1.20474517f, 0.0701450631f, 1.83124101f, 0, 2, 5, 1},
+    {1, 0, 18, 3, 3.48942304f, 0.0385456569f, 1.35604668f, 0, 2, 5, 1},
+    {1, 0, 18, 9, 3.0277276f, 0.132264882f, 0.789085746f, 0, 2, 5, 1},
+    {1, 0, 18, 10, 1.23664367f, 0.0701450631f, 1.87351906f, 0, 2, 5, 1},
+    {1, 0, 19, 3, 3.49980307f, 0.0385456569f, 1.34648085f, 0, 2, 5, 1},
+    {1, 0, 19, 9, 3.04418564f, 0.132264882f, 0.768158555f, 0, 2, 5, 1},
+    {1, 0, 19, 10, 1.26854217f, 0.0701450631f, 1.91579711f, 0, 2, 5, 1},
+    {1, 0, 19, 12, 1.87021947f, 0.0143328933f, 3.5023036f, 0, 2, 5, 1},
+    {1, 0, 20, 3, 3.5101831f, 0.0385456569f, 1.33691502f, 0, 2, 5, 1},
+    {1, 0, 20, 9, 3.06064367f, 0.132264882f, 0.747231364f, 0, 2, 5, 1},
+    {1, 0, 20, 10, 1.30044067f, 0.0701450631f, 1.95807517f, 0, 2, 5, 1},
+    {1, 0, 20, 12, 1.85312724f, 0.0143328933f, 3.49909401f, 0, 2, 5, 1},
+    {1, 0, 21, 3, 3.52056313f, 0.0385456569f, 1.32734919f, 0, 2, 5, 1},
+    {1, 0, 21, 9, 3.07710171f, 0.132264882f, 0.726304173f, 0, 2, 5, 1},
+    {1, 0, 21, 12, 1.83603501f, 0.0143328933f, 3.49588442f, 0, 2, 5, 1},
+    {1, 0, 21, 13, 1.08876812f, 0.0f, 3.58960724f, 0, 2, 5, 1},
+    {1, 0, 22, 3, 3.53094316f, 0.0385456569f, 1.31778336f, 0, 2, 5, 1},
+    {1, 0, 22, 9, 3.09355974f, 0.132264882f, 0.705376983f, 0, 2, 5, 1},
+    {1, 0, 22, 12, 1.81894279f, 0.0143328933f, 3.49267483f, 0, 2, 5, 1},
+    {1, 0, 22, 14, 1.36423767f, 0.0701450631f, 2.04263115f, 0, 2, 5, 1},
+    {1, 0, 22, 15, 1.24789011f, 0.0f, 1.07514071f, 0, 2, 5, 1},
+    {1, 0, 23, 3, 3.54132318f, 0.0385456569f, 1.30821753f, 0, 2, 5, 1},
+    {1, 0, 23, 9, 3.11001778f, 0.132264882f, 0.684449792f, 0, 2, 5, 1},
+    {1, 0, 23, 12, 1.80185056f, 0.0143328933f, 3.48946524f, 0, 2, 5, 1},
+    {1, 0, 23, 14, 1.39613616f, 0.0701450631f, 2.0849092f, 0, 2, 5, 1},
+    {1, 0, 23, 16, 1.9527905f, 0.0f, 4.50398731f, 0, 2, 5, 1},
+    {1, 0, 24, 3, 3.55170321f, 0.0385456569f, 1.2986517f, 0, 2, 5, 1},
+    {1, 0, 24, 9, 3.12647581f, 0.132264882f, 0.663522601f, 0, 2, 5, 1},
+    {1, 0, 24, 12, 1.78475833f, 0.0143328933f, 3.48625565f, 0, 2, 5, 1},
+    {1, 0, 24, 14, 1.42803466f, 0.0701450631f, 2.12718725f, 0, 2, 5, 1},
+    {1, 0, 25, 3, 3.56208324f, 0.0385456569f, 1.28908587f, 0, 2, 5, 1},
+    {1, 0, 25, 9, 3.14293385f, 0.132264882f, 0.64259541f, 0, 2, 5, 1},
+    {1, 0, 25, 12, 1.7676661f, 0.0143328933f, 3.48304605f, 0, 2, 5, 1},
+    {1, 0, 25, 14, 1.45993316f, 0.0701450631f, 2.1694653f, 0, 2, 5, 1},
+    {1, 0, 26, 3, 3.57246327f, 0.0385456569f, 1.27952003f, 0, 2, 5, 1},
+    {1, 0, 26, 9, 3.15939188f, 0.132264882f, 0.62166822f, 0, 2, 5, 1},
+    {1, 0, 26, 14, 1.49183166f, 0.0701450631f, 2.21174335f, 0, 2, 5, 1},
+    {1, 0, 26, 17, 3.20687389f, 0.0f, 2.83304334f, 0, 2, 5, 1},
+    {1, 0, 27, 3, 3.5828433f, 0.0385456569f, 1.2699542f, 0, 2, 5, 1},
+    {1, 0, 27, 9, 3.17584991f, 0.132264882f, 0.600741029f, 0, 2, 5, 1},
+    {1, 0, 27, 14, 1.52373016f, 0.0701450631f, 2.25402141f, 0, 2, 5, 1},
+    {1, 0, 27, 18, 3.77488565f, 0.0f, 3.64326859f, 0, 2, 5, 1},
+    {1, 0, 27, 19, 1.73348165f, 0.0143328933f, 3.47662687f, 0, 2, 5, 1},
+    {1, 0, 28, 3, 3.59322333f, 0.0385456569f, 1.26038837f, 0, 2, 5, 1},
+    {1, 0, 28, 9, 3.19230795f, 0.132264882f, 0.579813838f, 0, 2, 5, 1},
+    {1, 0, 28, 14, 1.55562866f, 0.0701450631f, 2.29629946f, 0, 2, 5, 1},
+    {1, 0, 28, 19, 1.71638942f, 0.0143328933f, 3.47341728f, 0, 2, 5, 1},
+    {1, 0, 28, 20, 2.52302384f, 0.0f, 3.58379054f, 0, 2, 5, 1},
+    {1, 0, 29, 3, 3.60360336f, 0.0385456569f, 1.25082254f, 0, 2, 5, 1},
+    {1, 0, 29, 9, 3.20876598f, 0.132264882f, 0.558886647f, 0, 2, 5, 1},
+    {1, 0, 29, 14, 1.58752716f, 0.0701450631f, 2.33857751f, 0, 2, 5, 1},
+    {1, 0, 29, 19, 1.69929719f, 0.0143328933f, 3.47020769f, 0, 2, 5, 1},
+    {1, 1, 0, 1, 2.1949718f, 0.0143328933f, 3.56328583f, 1, 2, 5, 0},
+    {1, 1, 0, 2, 0.662470102f, 0.0701450631f, 1.11251414f, 1, 2, 5, 0},
+    {1, 1, 0, 3, 3.3025825f, 0.0385456569f, 1.52823162f, 1, 2, 5, 0},
+    {1, 1, 0, 4, 2.73148298f, 0.132264882f, 1.16577518f, 1, 2, 5, 0},
+    {1, 1, 0, 5, 2.75809717f, 0.0f, 2.1747036f, 1, 2, 5, 0},
+    {1, 1, 1, 1, 2.17787957f, 0.0143328933f, 3.56007624f, 2, 2, 5, 0},
+    {1, 1, 1, 2, 0.69436866f, 0.0701450631f, 1.15479219f, 2, 2, 5, 0},
+    {1, 1, 1, 3, 3.31296253f, 0.0385456569f, 1.51866579f, 2, 2, 5, 0},
+    {1, 1, 1, 4, 2.74794102f, 0.132264882f, 1.14484799f, 2, 2, 5, 0},
+    {1, 1, 1, 5, 2.75809717f, 0.0f, 2.1747036f, 2, 1, 5, 0},
+    {1, 1, 2, 1, 2.16078734f, 0.0143328933f, 3.55686665f, 3, 2, 5, 0},
+    {1, 1, 2, 2, 0.69436866f, 0.0701450631f, 1.15479219f, 3, 1, 5, 0},
+    {1, 1, 2, 3, 3.32334256f, 0.0385456569f, 1.50909996f, 3, 2, 5, 0},
+    {1, 1, 2, 4, 2.76439905f, 0.132264882f, 1.1239208f, 3, 2, 5, 0},
+    {1, 1, 2, 5, 2.75809717f, 0.0f, 2.1747036f, 3, 0, 5, 0},
+    {1, 1, 3, 1, 2.14369512f, 0.0143328933f, 3.55365705f, 3, 2, 5, 1},
+    {1, 1, 3, 2, 0.758165777f, 0.0701450631f, 1.23934829f, 3, 1, 5, 1},
+    {1, 1, 3, 3, 3.33372259f, 0.0385456569f, 1.49953413f, 3, 2, 5, 1},
+    {1, 1, 3, 4, 2.78085709f, 0.132264882f, 1.10299361f, 3, 2, 5, 1},
+    {1, 1, 4, 1, 2.12660289f, 0.0143328933f, 3.55044746f, 4, 2, 5, 1},
+    {1, 1, 4, 2, 0.790064335f, 0.0701450631f, 1.28162634f, 4, 1, 5, 1},
+    {1, 1, 4, 3, 3.34410262f, 0.0385456569f, 1.4899683f, 4, 2, 5, 1},
+    {1, 1, 4, 4, 2.79731512f, 0.132264882f, 1.08206642f, 4, 2, 5, 1},
+    {1, 1, 5, 1, 2.10951066f, 0.0143328933f, 3.54723787f, 5, 2, 5, 1},
+    {1, 1, 5, 2, 0.821962893f, 0.0701450631f, 1.3239044f, 5, 1, 5, 1},
+    {1, 1, 5, 3, 3.35448265f, 0.0385456569f, 1.48040247f, 5, 2, 5, 1},
+    {1, 1, 5, 4, 2.81377316f, 0.132264882f, 1.06113923f, 5, 2, 5, 1},
+    {1, 1, 6, 1, 2.09241843f, 0.0143328933f, 3.54402828f, 6, 2, 5, 1},
+    {1, 1, 6, 2, 0.853861451f, 0.0701450631f, 1.36618245f, 6, 1, 5, 1},
+    {1, 1, 6, 3, 3.36486268f, 0.0385456569f, 1.47083664f, 6, 2, 5, 1},
+    {1, 1, 6, 4, 2.83023119f, 0.132264882f, 1.04021204f, 6, 2, 5, 1},
+    {1, 1, 7, 1, 2.0753262f, 0.0143328933f, 3.54081869f, 7, 2, 5, 1},
+    {1, 1, 7, 2, 0.885760009f, 0.0701450631f, 1.4084605f, 7, 1, 5, 1},
+    {1, 1, 7, 3, 3.37524271f, 0.0385456569f, 1.46127081f, 7, 2, 5, 1},
+    {1, 1, 7, 4, 2.84668922f, 0.132264882f, 1.01928484f, 7, 2, 5, 1},
+    {1, 1, 7, 6, 0.930588424f, 0.0f, 4.08343077f, 1, 2, 5, 0},
+    {1, 1, 8, 1, 2.05823398f, 0.0143328933f, 3.5376091f, 8, 2, 5, 1},
+    {1, 1, 8, 2, 0.917658567f, 0.0701450631f, 1.45073855f, 8, 1, 5, 1},
+    {1, 1, 8, 3, 3.38562274f, 0.0385456569f, 1.45170498f, 8, 2, 5, 1},
+    {1, 1, 8, 4, 2.84668922f, 0.132264882f, 1.01928484f, 8, 2, 4, 1},
+    {1, 1, 8, 6, 0.930588424f, 0.0f, 4.08343077f, 2, 1, 5, 0},
+    {1, 1, 9, 1, 2.04114175f, 0.0143328933f, 3.53439951f, 9, 2, 5, 1},
+    {1, 1, 9, 2, 0.917658567f, 0.0701450631f, 1.45073855f, 9, 1, 4, 1},
+    {1, 1, 9, 3, 3.39600277f, 0.0385456569f, 1.44213915f, 9, 2, 5, 1},
+    {1, 1, 9, 4, 2.84668922f, 0.132264882f, 1.01928484f, 9, 2, 3, 1},
+    {1, 1, 9, 6, 0.930588424f, 0.0f, 4.08343077f, 3, 0, 5, 0},
+    {1, 1, 10, 1, 2.02404952f, 0.0143328933f, 3.53118992f, 10, 2, 5, 1},
+    {1, 1, 10, 2, 0.981455684f, 0.0701450631f, 1.53529465f, 10, 1, 5, 1},
+    {1, 1, 10, 3, 3.4063828f, 0.0385456569f, 1.43257332f, 10, 2, 5, 1},
+    {1, 1, 10, 4, 2.89606333f, 0.132264882f, 0.956503272f, 10, 2, 5, 1},
+    {1, 1, 11, 1, 2.00695729f, 0.0143328933f, 3.52798033f, 11, 2, 5, 1},
+    {1, 1, 11, 2, 1.01335418f, 0.0701450631f, 1.5775727f, 11, 1, 5, 1},
+    {1, 1, 11, 3, 3.41676283f, 0.0385456569f, 1.42300749f, 11, 2, 5, 1},
+    {1, 1, 11, 4, 2.91252136f, 0.132264882f, 0.935576081f, 11, 2, 5, 1},
+    {1, 1, 12, 1, 1.98986506f, 0.0143328933f, 3.52477074f, 12, 2, 5, 1},
+    {1, 1, 12, 2, 1.01335418f, 0.0701450631f, 1.5775727f, 12, 1, 4, 1},
+    {1, 1, 12, 3, 3.42714286f, 0.0385456569f, 1.41344166f, 12, 2, 5, 1},
+    {1, 1, 12, 4, 2.9289794f, 0.132264882f, 0.91464889f, 12, 2, 5, 1},
+    {1, 1, 13, 1, 1.97277284f, 0.0143328933f, 3.52156115f, 13, 2, 5, 1},
+    {1, 1, 13, 2, 1.01335418f, 0.0701450631f, 1.5775727f, 13, 1, 3, 1},
+    {1, 1, 13, 3, 3.43752289f, 0.0385456569f, 1.40387583f, 13, 2, 5, 1},
+    {1, 1, 13, 4, 2.94543743f, 0.132264882f, 0.8937217f, 13, 2, 5, 1},
+    {1, 1, 14, 1, 1.95568061f, 0.0143328933f, 3.51835155f, 14, 2, 5, 1},
+    {1, 1, 14, 2, 1.10904968f, 0.0701450631f, 1.70440686f, 14, 1, 5, 1},
+    {1, 1, 14, 3, 3.44790292f, 0.0385456569f, 1.39431f, 14, 2, 5, 1},
+    {1, 1, 14, 4, 2.96189547f, 0.132264882f, 0.872794509f, 14, 2, 5, 1},
+    {1, 1, 15, 1, 1.93858838f, 0.0143328933f, 3.51514196f, 15, 2, 5, 1},
+    {1, 1, 15, 2, 1.14094818f, 0.0701450631f, 1.74668491f, 15, 1, 5, 1},
+    {1, 1, 15, 3, 3.45828295f, 0.0385456569f, 1.38474417f, 15, 2, 5, 1},
+    {1, 1, 15, 4, 2.9783535f, 0.132264882f, 0.851867318f, 15, 2, 5, 1},
+    {1, 1, 16, 1, 1.92149615f, 0.0143328933f, 3.51193237f, 16, 2, 5, 1},
+    {1, 1, 16, 2, 1.17284667f, 0.0701450631f, 1.78896296f, 16, 1, 5, 1},
+    {1, 1, 16, 3, 3.46866298f, 0.0385456569f, 1.37517834f, 16, 2, 5, 1},
+    {1, 1, 16, 4, 2.99481153f, 0.132264882f, 0.830940127f, 16, 2, 5, 1},
+    {1, 1, 16, 7, 1.57784665f, 0.0f, 4.71801949f, 1, 2, 5, 0},
+    {1, 1, 17, 1, 1.90440392f, 0.0143328933f, 3.50872278f, 17, 2, 5, 1},
+    {1, 1, 17, 2, 1.20474517f, 0.0701450631f, 1.83124101f, 17, 1, 5, 1},
+    {1, 1, 17, 3, 3.47904301f, 0.0385456569f, 1.36561251f, 17, 2, 5, 1},
+    {1, 1, 17, 4, 3.01126957f, 0.132264882f, 0.810012937f, 17, 2, 5, 1},
+    {1, 1, 17, 7, 1.57784665f, 0.0f, 4.71801949f, 2, 1, 5, 0},
+    {1, 1, 18, 1, 1.90440392f, 0.0143328933f, 3.50872278f, 18, 2, 4, 1},
+    {1, 1, 18, 2, 1.23664367f, 0.0701450631f, 1.87351906f, 18, 1, 5, 1},
+    {1, 1, 18, 3, 3.48942304f, 0.0385456569f, 1.35604668f, 18, 2, 5, 1},
+    {1, 1, 18, 4, 3.0277276f, 0.132264882f, 0.789085746f, 18, 2, 5, 1},
+    {1, 1, 18, 7, 1.57784665f, 0.0f, 4.71801949f, 3, 0, 5, 0},
+    {1, 1, 19, 1, 1.87021947f, 0.0143328933f, 3.5023036f, 19, 2, 5, 1},
+    {1, 1, 19, 2, 1.26854217f, 0.0701450631f, 1.91579711f, 19, 1, 5, 1},
+    {1, 1, 19, 3, 3.49980307f, 0.0385456569f, 1.34648085f, 19, 2, 5, 1},
+    {1, 1, 19, 4, 3.04418564f, 0.132264882f, 0.768158555f, 19, 2, 5, 1},
+    {1, 1, 20, 1, 1.85312724f, 0.0143328933f, 3.49909401f, 20, 2, 5, 1},
+    {1, 1, 20, 2, 1.30044067f, 0.0701450631f, 1.95807517f, 20, 1, 5, 1},
+    {1, 1, 20, 3, 3.5101831f, 0.0385456569f, 1.33691502f, 20, 2, 5, 1},
+    {1, 1, 20, 4, 3.06064367f, 0.132264882f, 0.747231364f, 20, 2, 5, 1},
+    {1, 1, 21, 1, 1.83603501f, 0.0143328933f, 3.49588442f, 21, 2, 5, 1},
+    {1, 1, 21, 2, 1.30044067f, 0.0701450631f, 1.95807517f, 21, 1, 4, 1},
+    {1, 1, 21, 3, 3.52056313f, 0.0385456569f, 1.32734919f, 21, 2, 5, 1},
+    {1, 1, 21, 4, 3.07710171f, 0.132264882f, 0.726304173f, 21, 2, 5, 1},
+    {1, 1, 21, 8, 1.08876812f, 0.0f, 3.58960724f, 1, 2, 5, 0},
+    {1, 1, 22, 1, 1.81894279f, 0.0143328933f, 3.49267483f, 22, 2, 5, 1},
+    {1, 1, 22, 2, 1.36423767f, 0.0701450631f, 2.04263115f, 22, 1, 5, 1},
+    {1, 1, 22, 3, 3.53094316f, 0.0385456569f, 1.31778336f, 22, 2, 5, 1},
+    {1, 1, 22, 4, 3.09355974f, 0.132264882f, 0.705376983f, 22, 2, 5, 1},
+    {1, 1, 22, 8, 1.08876812f, 0.0f, 3.58960724f, 2, 1, 5, 0},
+    {1, 1, 22, 9, 1.24789011f, 0.0f, 1.07514071f, 1, 2, 5, 0},
+    {1, 1, 23, 1, 1.80185056f, 0.0143328933f, 3.48946524f, 23, 2, 5, 1},
+    {1, 1, 23, 2, 1.39613616f, 0.0701450631f, 2.0849092f, 23, 1, 5, 1},
+    {1, 1, 23, 3, 3.54132318f, 0.0385456569f, 1.30821753f, 23, 2, 5, 1},
+    {1, 1, 23, 4, 3.11001778f, 0.132264882f, 0.684449792f, 23, 2, 5, 1},
+    {1, 1, 23, 8, 1.08876812f, 0.0f, 3.58960724f, 3, 0, 5, 0},
+    {1, 1, 23, 9, 1.24789011f, 0.0f, 1.07514071f, 2, 1, 5, 0},
+    {1, 1, 23, 10, 1.9527905f, 0.0f, 4.50398731f, 1, 2, 5, 0},
+    {1, 1, 24, 1, 1.78475833f, 0.0143328933f, 3.48625565f, 24, 2, 5, 1},
+    {1, 1, 24, 2, 1.42803466f, 0.0701450631f, 2.12718725f, 24, 1, 5, 1},
+    {1, 1, 24, 3, 3.55170321f, 0.0385456569f, 1.2986517f, 24, 2, 5, 1},
+    {1, 1, 24, 4, 3.12647581f, 0.132264882f, 0.663522601f, 24, 2, 5, 1},
+    {1, 1, 24, 9, 1.24789011f, 0.0f, 1.07514071f, 3, 0, 5, 0},
+    {1, 1, 24, 10, 1.9527905f, 0.0f, 4.50398731f, 2, 1, 5, 0},
+    {1, 1, 25, 1, 1.7676661f, 0.0143328933f, 3.48304605f, 25, 2, 5, 1},
+    {1, 1, 25, 2, 1.45993316f, 0.0701450631f, 2.1694653f, 25, 1, 5, 1},
+    {1, 1, 25, 3, 3.56208324f, 0.0385456569f, 1.28908587f, 25, 2, 5, 1},
+    {1, 1, 25, 4, 3.14293385f, 0.132264882f, 0.64259541f, 25, 2, 5, 1},
+    {1, 1, 25, 10, 1.9527905f, 0.0f, 4.50398731f, 3, 0, 5, 0},
+    {1, 1, 26, 1, 1.7676661f, 0.0143328933f, 3.48304605f, 26, 2, 4, 1},
+    {1, 1, 26, 2, 1.49183166f, 0.0701450631f, 2.21174335f, 26, 1, 5, 1},
+    {1, 1, 26, 3, 3.57246327f, 0.0385456569f, 1.27952003f, 26, 2, 5, 1},
+    {1, 1, 26, 4, 3.15939188f, 0.132264882f, 0.62166822f, 26, 2, 5, 1},
+    {1, 1, 26, 11, 3.20687389f, 0.0f, 2.83304334f, 1, 2, 5, 0},
+    {1, 1, 27, 1, 1.73348165f, 0.0143328933f, 3.47662687f, 27, 2, 5, 1},
+    {1, 1, 27, 2, 1.52373016f, 0.0701450631f, 2.25402141f, 27, 1, 5, 1},
+    {1, 1, 27, 3, 3.5828433f, 0.0385456569f, 1.2699542f, 27, 2, 5, 1},
+    {1, 1, 27, 4, 3.17584991f, 0.132264882f, 0.600741029f, 27, 2, 5, 1},
+    {1, 1, 27, 11, 3.20687389f, 0.0f, 2.83304334f, 2, 1, 5, 0},
+    {1, 1, 27, 12, 3.77488565f, 0.0f, 3.64326859f, 1, 2, 5, 0},
+    {1, 1, 28, 1, 1.71638942f, 0.0143328933f, 3.47341728f, 28, 2, 5, 1},
+    {1, 1, 28, 2, 1.55562866f, 0.0701450631f, 2.29629946f, 28, 1, 5, 1},
+    {1, 1, 28, 3, 3.59322333f, 0.0385456569f, 1.26038837f, 28, 2, 5, 1},
+    {1, 1, 28, 4, 3.19230795f, 0.132264882f, 0.579813838f, 28, 2, 5, 1},
+    {1, 1, 28, 11, 3.20687389f, 0.0f, 2.83304334f, 3, 0, 5, 0},
+    {1, 1, 28, 12, 3.77488565f, 0.0f, 3.64326859f, 2, 1, 5, 0},
+    {1, 1, 28, 13, 2.52302384f, 0.0f, 3.58379054f, 1, 2, 5, 0},
+    {1, 1, 29, 1, 1.69929719f, 0.0143328933f, 3.47020769f, 29, 2, 5, 1},
+    {1, 1, 29, 2, 1.58752716f, 0.0701450631f, 2.33857751f, 29, 1, 5, 1},
+    {1, 1, 29, 3, 3.60360336f, 0.0385456569f, 1.25082254f, 29, 2, 5, 1},
+    {1, 1, 29, 4, 3.20876598f, 0.132264882f, 0.558886647f, 29, 2, 5, 1},
+    {1, 1, 29, 12, 3.77488565f, 0.0f, 3.64326859f, 3, 0, 5, 0},
+    {1, 1, 29, 13, 2.52302384f, 0.0f, 3.58379054f, 2, 1, 5, 0}
+};
+
+
+#endif //PEOPLE_DETECTION_TRACKER_GOLDEN_FIXTURE_H